@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "lexer.h"
 
 // Function to convert token type to string
@@ -96,9 +97,186 @@ void printToken(Token* token) {
     }
 }
 
+// errorType is only set on TK_ERROR tokens
+static int sameToken(Token* a, Token* b) {
+    if (a->type != b->type || a->lineNo != b->lineNo) {
+        return 0;
+    }
+    if (a->type == TK_ERROR && a->errorType != b->errorType) {
+        return 0;
+    }
+    if (a->lexeme == NULL || b->lexeme == NULL) {
+        return a->lexeme == b->lexeme;
+    }
+    return strcmp(a->lexeme, b->lexeme) == 0;
+}
+
+static void freeToken(Token* token) {
+    free(token->lexeme);
+    free(token);
+}
+
+// Lex the whole file with the pull lexer, recording a checkpoint every intervalKB KB.
+// starts[i] is the offset getNextToken was called at for token i.
+static Token** lexFile(FILE* fp, int intervalKB, long** starts, int* numTokens) {
+    Token** tokens = NULL;
+    int count = 0, capacity = 0;
+    
+    enableLexerCheckpoints(intervalKB);
+    initLexer(fp);
+    *starts = NULL;
+    while (1) {
+        long offset = getLexerOffset();
+        Token* token = getNextToken();
+        if (token == NULL) {
+            break;
+        }
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 1024;
+            tokens = (Token**)realloc(tokens, capacity * sizeof(Token*));
+            *starts = (long*)realloc(*starts, capacity * sizeof(long));
+        }
+        (*starts)[count] = offset;
+        tokens[count++] = token;
+    }
+    *numTokens = count;
+    return tokens;
+}
+
+// Seek to every checkpoint and check that lexing from there gives the same tokens as the
+// full pass did from that offset on (none for a checkpoint at the end of the input)
+static int checkCheckpoints(Token** tokens, long* starts, int numTokens) {
+    const LexerCheckpoint* checkpoints;
+    int numCheckpoints = getLexerCheckpoints(&checkpoints);
+    int failures = 0;
+    
+    for (int c = 0; c < numCheckpoints; c++) {
+        int first = 0;
+        while (first < numTokens && starts[first] < checkpoints[c].offset) {
+            first++;
+        }
+        // The call that found the end of the input may record the last checkpoint
+        if ((first < numTokens && starts[first] != checkpoints[c].offset) ||
+            findLexerCheckpoint(checkpoints[c].offset) != &checkpoints[c] || seekLexer(&checkpoints[c]) != 0) {
+            printf("Checkpoint at offset %ld: cannot restart there\n", checkpoints[c].offset);
+            failures++;
+            continue;
+        }
+        
+        int i = first;
+        Token* token;
+        while ((token = getNextToken()) != NULL) {
+            if (i < numTokens && !sameToken(token, tokens[i])) {
+                printf("Checkpoint at offset %ld: token %d differs after re-lexing\n", checkpoints[c].offset, i);
+                freeToken(token);
+                failures++;
+                break;
+            }
+            i++;
+            freeToken(token);
+        }
+        if (token == NULL && i != numTokens) {
+            printf("Checkpoint at offset %ld: %d tokens after re-lexing, expected %d\n",
+                   checkpoints[c].offset, i - first, numTokens - first);
+            failures++;
+        }
+    }
+    
+    printf("Checkpoints: %d re-lexed, %d failed\n", numCheckpoints, failures);
+    return failures;
+}
+
+// Feed the file to a push lexer in chunks and check that it returns the tokens of the
+// pull pass. chunkSize 0 picks a random size from 1 to 4096 for every chunk.
+static int checkPushLexer(const char* bytes, long size, int chunkSize, Token** tokens, int numTokens) {
+    LexerContext* ctx = createPushLexer();
+    int matched = 0, failures = 0;
+    long fed = 0;
+    
+    while (1) {
+        int n = chunkSize > 0 ? chunkSize : 1 + rand() % 4096;
+        if (n > size - fed) {
+            n = (int)(size - fed);
+        }
+        
+        int count;
+        Token** chunk = lexerFeed(ctx, bytes + fed, n, &count);
+        for (int i = 0; i < count; i++) {
+            if (failures == 0 && (matched >= numTokens || !sameToken(chunk[i], tokens[matched]))) {
+                printf("Push lexer, %s chunks: token %d differs\n", chunkSize > 0 ? "fixed" : "random", matched);
+                failures++;
+            }
+            matched++;
+            freeToken(chunk[i]);
+        }
+        free(chunk);
+        
+        fed += n;
+        if (n == 0) {
+            break;
+        }
+    }
+    freePushLexer(ctx);
+    
+    if (failures == 0 && matched != numTokens) {
+        printf("Push lexer, %s chunks: %d tokens, expected %d\n", chunkSize > 0 ? "fixed" : "random",
+               matched, numTokens);
+        failures++;
+    }
+    return failures;
+}
+
+// driver --check <source_file> lexes the file once and checks the other lexer modes
+// against that pass
+static int runChecks(const char* filename) {
+    FILE* fp = fopen(filename, "r");
+    if (!fp) {
+        printf("Error: Cannot open file %s\n", filename);
+        return 1;
+    }
+    
+    long* starts;
+    int numTokens;
+    Token** tokens = lexFile(fp, 1, &starts, &numTokens);
+    printf("%s: %d tokens\n", filename, numTokens);
+    
+    int failures = checkCheckpoints(tokens, starts, numTokens);
+    enableLexerCheckpoints(0);
+    
+    // The same file pushed one byte at a time, then in random chunk sizes
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    char* bytes = (char*)malloc(size > 0 ? size : 1);
+    rewind(fp);
+    if (fread(bytes, 1, size, fp) != (size_t)size) {
+        printf("Error: Cannot read file %s\n", filename);
+        failures++;
+    } else {
+        int pushFailures = checkPushLexer(bytes, size, 1, tokens, numTokens);
+        srand(1);
+        for (int round = 0; round < 20; round++) {
+            pushFailures += checkPushLexer(bytes, size, 0, tokens, numTokens);
+        }
+        printf("Push lexer: 1 byte and 20 random chunk size runs, %d failed\n", pushFailures);
+        failures += pushFailures;
+    }
+    free(bytes);
+    
+    for (int i = 0; i < numTokens; i++) {
+        freeToken(tokens[i]);
+    }
+    free(tokens);
+    free(starts);
+    fclose(fp);
+    return failures > 0;
+}
+
 int main(int argc, char* argv[]) {
+    if (argc == 3 && strcmp(argv[1], "--check") == 0) {
+        return runChecks(argv[2]);
+    }
     if (argc != 2) {
-        printf("Usage: %s <source_file>\n", argv[0]);
+        printf("Usage: %s [--check] <source_file>\n", argv[0]);
         return 1;
     }
 
@@ -77,8 +77,27 @@ typedef struct {
     int errorType;  // 1: Length error, 2: Unknown symbol, 3: Unknown pattern
 } Token;
 
+// A point the lexer can be restarted from: input byte offset, line number there and
+// DFA state, which is always the start state since checkpoints sit at token boundaries
+typedef struct {
+    long offset;
+    int lineNo;
+    int state;
+} LexerCheckpoint;
+
+// Lexer state for push mode, see lexerFeed
+typedef struct LexerBuffer LexerContext;
+
 void initLexer(FILE* fp);
 Token* getNextToken(void);
 void removeComments(char* inputFile, char* cleanFile);
+void enableLexerCheckpoints(int intervalKB);
+int getLexerCheckpoints(const LexerCheckpoint** checkpoints);
+const LexerCheckpoint* findLexerCheckpoint(long offset);
+long getLexerOffset(void);
+int seekLexer(const LexerCheckpoint* checkpoint);
+LexerContext* createPushLexer(void);
+Token** lexerFeed(LexerContext* ctx, const char* bytes, int n, int* numTokens);
+void freePushLexer(LexerContext* ctx);
 
 #endif
\ No newline at end of file
@@ -2,99 +2,247 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 #include "lexer.h"
-#include "keyword_table.h"
 
 #define BUFFER_SIZE 4096
 #define MAX_LEXEME_LEN 50
 #define MAX_ID_LEN 20
 #define MAX_FUNID_LEN 30
 
-static int isIdChar(char c) {
-    return (isalnum(c) || c == '_');
-}
+// Actions the token specification can give a rule besides returning a TK_* token
+enum {
+    LEX_SKIP = TK_ERROR + 1,
+    LEX_COMMENT,
+    LEX_UNKNOWN_SYMBOL,
+    LEX_UNKNOWN_PATTERN
+};
 
+// Up to three byte ranges [lo, hi] on which a DFA state loops to itself
 typedef struct {
-    char buffer1[BUFFER_SIZE];
-    char buffer2[BUFFER_SIZE];
-    int currentBuffer;
+    unsigned char numRanges;
+    char lo[3];
+    char hi[3];
+} LexLoop;
+
+#include "lexer_tables.h"
+
+// Whitespace and comment skipping look at 32 (AVX2) or 16 (SSE2) bytes per step: compare,
+// movemask, and the lowest clear/set bit is where the run ends. The scalar loops handle
+// the tail and builds without either instruction set.
+#if defined(__AVX2__)
+#define SKIP_STRIDE 32
+typedef __m256i SkipVector;
+#define skipLoad(p) _mm256_loadu_si256((const __m256i*)(p))
+#define skipSplat(b) _mm256_set1_epi8(b)
+#define skipEq(a, b) _mm256_cmpeq_epi8(a, b)
+#define skipGt(a, b) _mm256_cmpgt_epi8(a, b)
+#define skipAnd(a, b) _mm256_and_si256(a, b)
+#define skipOr(a, b) _mm256_or_si256(a, b)
+#define skipMask(v) ((unsigned int)_mm256_movemask_epi8(v))
+#elif defined(__SSE2__)
+#define SKIP_STRIDE 16
+typedef __m128i SkipVector;
+#define skipLoad(p) _mm_loadu_si128((const __m128i*)(p))
+#define skipSplat(b) _mm_set1_epi8(b)
+#define skipEq(a, b) _mm_cmpeq_epi8(a, b)
+#define skipGt(a, b) _mm_cmpgt_epi8(a, b)
+#define skipAnd(a, b) _mm_and_si128(a, b)
+#define skipOr(a, b) _mm_or_si128(a, b)
+#define skipMask(v) ((unsigned int)_mm_movemask_epi8(v))
+#endif
+
+// Index of the first byte in buffer[from, to) that isspace() rejects, to if there is none.
+// The newlines passed over are added to *newlines.
+static int skipSpaces(const char* buffer, int from, int to, int* newlines) {
+    int i = from;
+#ifdef SKIP_STRIDE
+    const SkipVector space = skipSplat(' ');
+    const SkipVector newline = skipSplat('\n');
+    const SkipVector below = skipSplat('\t' - 1);
+    const SkipVector above = skipSplat('\r' + 1);
+    for (; i + SKIP_STRIDE <= to; i += SKIP_STRIDE) {
+        SkipVector v = skipLoad(buffer + i);
+        // ' ' or \t..\r; bytes >= 0x80 are negative, so the signed range test rejects them
+        SkipVector isSpace = skipOr(skipEq(v, space), skipAnd(skipGt(v, below), skipGt(above, v)));
+        unsigned int spaces = skipMask(isSpace);
+        unsigned int lines = skipMask(skipEq(v, newline));
+        if (spaces != (unsigned int)((1ULL << SKIP_STRIDE) - 1)) {
+            int run = __builtin_ctz(~spaces);
+            *newlines += __builtin_popcount(lines & ((1U << run) - 1));
+            return i + run;
+        }
+        *newlines += __builtin_popcount(lines);
+    }
+#endif
+    for (; i < to && isspace((unsigned char)buffer[i]); i++) {
+        if (buffer[i] == '\n') {
+            (*newlines)++;
+        }
+    }
+    return i;
+}
+
+// Index of the first byte in buffer[from, to) outside the ranges of loop, to if there is
+// none. Unused ranges are empty (1, 0).
+static int scanLoop(const char* buffer, int from, int to, const LexLoop* loop) {
+    int i = from;
+#ifdef SKIP_STRIDE
+    SkipVector below[3], above[3];
+    for (int r = 0; r < 3; r++) {
+        below[r] = skipSplat(loop->lo[r] - 1);
+        above[r] = skipSplat(loop->hi[r] + 1);
+    }
+    for (; i + SKIP_STRIDE <= to; i += SKIP_STRIDE) {
+        SkipVector v = skipLoad(buffer + i);
+        // Signed compares: the ranges stay below 0x7F and bytes >= 0x80 are negative
+        SkipVector inRun = skipOr(skipOr(skipAnd(skipGt(v, below[0]), skipGt(above[0], v)),
+                                         skipAnd(skipGt(v, below[1]), skipGt(above[1], v))),
+                                  skipAnd(skipGt(v, below[2]), skipGt(above[2], v)));
+        unsigned int run = skipMask(inRun);
+        if (run != (unsigned int)((1ULL << SKIP_STRIDE) - 1)) {
+            return i + __builtin_ctz(~run);
+        }
+    }
+#endif
+    for (; i < to; i++) {
+        char c = buffer[i];
+        if (!((c >= loop->lo[0] && c <= loop->hi[0]) || (c >= loop->lo[1] && c <= loop->hi[1]) ||
+              (c >= loop->lo[2] && c <= loop->hi[2]))) {
+            break;
+        }
+    }
+    return i;
+}
+
+// Index of the first '\n' in buffer[from, to), to if there is none
+static int findNewline(const char* buffer, int from, int to) {
+    int i = from;
+#ifdef SKIP_STRIDE
+    const SkipVector newline = skipSplat('\n');
+    for (; i + SKIP_STRIDE <= to; i += SKIP_STRIDE) {
+        unsigned int lines = skipMask(skipEq(skipLoad(buffer + i), newline));
+        if (lines) {
+            return i + __builtin_ctz(lines);
+        }
+    }
+#endif
+    while (i < to && buffer[i] != '\n') {
+        i++;
+    }
+    return i;
+}
+
+// The input is read BUFFER_SIZE bytes at a time into one window. A refill slides the
+// window forward but keeps everything from begin on, so the lexeme being matched and the
+// lookahead past it are always contiguous, wherever the chunk boundaries fall.
+// buffer[length] always holds LEX_SENTINEL, on which every DFA state is dead, so the
+// matcher reads without bounds checks and only a stop on that byte has to ask whether it
+// is the end of the window (refill or EOF) or a real byte of the input.
+// In push mode (fp is NULL) the bytes come from lexerFeed instead of fread.
+typedef struct LexerBuffer {
+    char* buffer;
+    int capacity;
+    int length;         // valid bytes in buffer, followed by LEX_SENTINEL
+    long startOffset;   // byte offset in the input of buffer[0]
     int forward;
     int begin;
     FILE* fp;
     int lineNo;
     int eof;
+    int starved;        // push mode only: a token ran into the end of the bytes fed so far
 } LexerBuffer;
 
 // Global variables
 static LexerBuffer* lexerBuffer = NULL;
-static KeywordTable* keywordTable = NULL;
-static int currentState = 0;
+
+// Checkpoints, recorded at token boundaries when an interval is set
+static long checkpointInterval = 0;
+static long nextCheckpoint = 0;
+static LexerCheckpoint* checkpoints = NULL;
+static int numCheckpoints = 0;
+static int checkpointCapacity = 0;
 
 // Forward declarations
 static FILE* getStream(FILE* fp);
-static char getNextChar(void);
-static void retract(int count);
+static int getNextChar(void);
+static int peekChar(int k);
 static char* getLexeme(void);
-static int isKeyword(const char* str);
+static void recordCheckpoint(void);
+static void slideWindow(int extra);
 
 // Initialize lexer
 void initLexer(FILE* fp) {
     lexerBuffer = (LexerBuffer*)malloc(sizeof(LexerBuffer));
+    lexerBuffer->capacity = 2 * BUFFER_SIZE;
+    lexerBuffer->buffer = (char*)malloc(lexerBuffer->capacity);
+    lexerBuffer->buffer[0] = LEX_SENTINEL;
+    lexerBuffer->length = 0;
+    lexerBuffer->startOffset = 0;
     lexerBuffer->fp = fp;
-    lexerBuffer->currentBuffer = 1;
     lexerBuffer->forward = 0;
     lexerBuffer->begin = 0;
     lexerBuffer->lineNo = 1;
     lexerBuffer->eof = 0;
+    lexerBuffer->starved = 0;
     
-    memset(lexerBuffer->buffer1, EOF, BUFFER_SIZE);
-    memset(lexerBuffer->buffer2, EOF, BUFFER_SIZE);
+    numCheckpoints = 0;
+    nextCheckpoint = 0;
     
-    keywordTable = initKeywordTable();
     getStream(lexerBuffer->fp);
 }
 
+// Drop what lies before the current lexeme and make room for extra more bytes and the
+// sentinel after them
+static void slideWindow(int extra) {
+    int keep = lexerBuffer->length - lexerBuffer->begin;
+    if (lexerBuffer->begin > 0) {
+        memmove(lexerBuffer->buffer, lexerBuffer->buffer + lexerBuffer->begin, keep);
+        lexerBuffer->startOffset += lexerBuffer->begin;
+        lexerBuffer->forward -= lexerBuffer->begin;
+        lexerBuffer->length = keep;
+        lexerBuffer->begin = 0;
+    }
+    while (keep + extra + 1 > lexerBuffer->capacity) {
+        lexerBuffer->capacity *= 2;
+        lexerBuffer->buffer = (char*)realloc(lexerBuffer->buffer, lexerBuffer->capacity);
+    }
+}
+
 // Get next chunk of file into buffer
 static FILE* getStream(FILE* fp) {
     if (fp == NULL || lexerBuffer->eof) {
         return NULL;
     }
 
-    char* targetBuffer = (lexerBuffer->currentBuffer == 1) ? 
-                        lexerBuffer->buffer1 : lexerBuffer->buffer2;
-    
-    size_t bytesRead = fread(targetBuffer, sizeof(char), BUFFER_SIZE-1, fp);
-    if (bytesRead < BUFFER_SIZE-1) {
-        targetBuffer[bytesRead] = EOF;
+    slideWindow(BUFFER_SIZE);
+    size_t bytesRead = fread(lexerBuffer->buffer + lexerBuffer->length, sizeof(char), BUFFER_SIZE, fp);
+    lexerBuffer->length += bytesRead;
+    lexerBuffer->buffer[lexerBuffer->length] = LEX_SENTINEL;
+    if (bytesRead < BUFFER_SIZE) {
         lexerBuffer->eof = 1;
     }
     
     return fp;
 }
 
-// Get next character from buffer
-static char getNextChar(void) {
-    char c;
-    if (lexerBuffer->currentBuffer == 1) {
-        c = lexerBuffer->buffer1[lexerBuffer->forward];
-        if (lexerBuffer->forward >= BUFFER_SIZE-1) {
-            getStream(lexerBuffer->fp);
-            lexerBuffer->currentBuffer = 2;
-            lexerBuffer->forward = 0;
-        } else {
-            lexerBuffer->forward++;
-        }
-    } else {
-        c = lexerBuffer->buffer2[lexerBuffer->forward];
-        if (lexerBuffer->forward >= BUFFER_SIZE-1) {
-            getStream(lexerBuffer->fp);
-            lexerBuffer->currentBuffer = 1;
-            lexerBuffer->forward = 0;
-        } else {
-            lexerBuffer->forward++;
+// Get next character from buffer as an unsigned char, EOF once the input is exhausted
+static int getNextChar(void) {
+    unsigned char c = lexerBuffer->buffer[lexerBuffer->forward];
+    if (c == LEX_SENTINEL && lexerBuffer->forward == lexerBuffer->length) {
+        getStream(lexerBuffer->fp);
+        if (lexerBuffer->forward >= lexerBuffer->length) {
+            if (!lexerBuffer->eof) {
+                lexerBuffer->starved = 1;  // more bytes may still be fed
+            }
+            return EOF;
         }
+        c = lexerBuffer->buffer[lexerBuffer->forward];
     }
     
+    lexerBuffer->forward++;
     if (c == '\n') {
         lexerBuffer->lineNo++;
     }
@@ -102,889 +250,316 @@ static char getNextChar(void) {
     return c;
 }
 
-static void retract(int count) {
-    while (count > 0) {
-        if (lexerBuffer->forward == 0) {
-            // Switch to the previous buffer
-            lexerBuffer->currentBuffer = (lexerBuffer->currentBuffer == 1) ? 2 : 1;
-            lexerBuffer->forward = BUFFER_SIZE - 1;
-        } else {
-            // Check which buffer is active before checking previous character
-            char prevChar = (lexerBuffer->currentBuffer == 1) ? 
-                lexerBuffer->buffer1[lexerBuffer->forward - 1] : 
-                lexerBuffer->buffer2[lexerBuffer->forward - 1];
-
-            if (prevChar == '\n') {
-                lexerBuffer->lineNo--;  // Only decrement if crossing a newline
+// Byte k places past forward as an unsigned char, without consuming it; EOF past the end
+// of the input. Refills the window as far as needed, so any lookahead distance works.
+static int peekChar(int k) {
+    while (lexerBuffer->forward + k >= lexerBuffer->length) {
+        if (lexerBuffer->eof || lexerBuffer->fp == NULL) {
+            if (!lexerBuffer->eof) {
+                lexerBuffer->starved = 1;  // more bytes may still be fed
             }
-
-            lexerBuffer->forward--;
+            return EOF;
         }
-        count--;
+        getStream(lexerBuffer->fp);
     }
+    return (unsigned char)lexerBuffer->buffer[lexerBuffer->forward + k];
 }
 
-
 // Get the current lexeme
-// Add to getLexeme():
 static char* getLexeme() {
     char* lexeme = (char*)malloc(MAX_LEXEME_LEN * sizeof(char));
-    int i = 0;
-    int bufferIndex = lexerBuffer->begin;
-    int bufferNum = lexerBuffer->currentBuffer;
-    
-    // Continue until we reach the current position or a token delimiter
-    while (bufferIndex != lexerBuffer->forward && i < MAX_LEXEME_LEN - 1) {
-        char c;
-        if (bufferNum == 1) {
-            c = lexerBuffer->buffer1[bufferIndex];
-        } else {
-            c = lexerBuffer->buffer2[bufferIndex];
-        }
-        
-        // Check if we've reached a non-lexeme character
-        // Don't break on alphanumeric chars or underscore, as they're valid in identifiers
-        lexeme[i++] = c;
-        
-        bufferIndex++;
-        if (bufferIndex >= BUFFER_SIZE) {
-            bufferNum = (bufferNum == 1) ? 2 : 1;
-            bufferIndex = 0;
-        }
+    int end = lexerBuffer->forward;
+    if (end > lexerBuffer->length) {
+        end = lexerBuffer->length;
+    }
+    int len = end - lexerBuffer->begin;
+    if (len > MAX_LEXEME_LEN - 1) {
+        len = MAX_LEXEME_LEN - 1;
+    }
+    if (len < 0) {
+        len = 0;
     }
     
-    lexeme[i] = '\0';
+    memcpy(lexeme, lexerBuffer->buffer + lexerBuffer->begin, len);
+    lexeme[len] = '\0';
     return lexeme;
 }
 
-
-// Check if a string is a keyword
-static int isKeyword(const char* str) {
-    TokenType type = lookupKeyword(keywordTable, str);
-    return (type != TK_ID);
-}
-
-Token* getNextToken(void) {
-    currentState = 1; // Initial state from DFA
-    char c;
-    Token* token = (Token*)malloc(sizeof(Token));
-    char numBuffer[32] = {0};
-    int numLen = 0;
+// Checkpoints are taken at the start of getNextToken, where the DFA is in LEX_START and
+// nothing has been read ahead, so lexing can restart there with no other context
+static void recordCheckpoint(void) {
+    long offset = lexerBuffer->startOffset + lexerBuffer->forward;
+    if (offset < nextCheckpoint) {
+        return;
+    }
+    // Re-lexing after a seek passes the same offsets again
+    if (numCheckpoints > 0 && offset <= checkpoints[numCheckpoints - 1].offset) {
+        return;
+    }
     
-    while (1) {
-        c = getNextChar();
-        
-        switch (currentState) {
-            case 1: // Initial/Start state (center of DFA)
-                if (c == EOF) {
-                    free(token);
-                    return NULL;
-                }
-                
-                lexerBuffer->begin = lexerBuffer->forward - 1;
-                
-                if (isspace(c)) {
-                    //if (c == '\n') lexerBuffer->lineNo++;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    continue;
-                }
-
-                // Comment handling (shown in DFA)
-                if (c == '%') {
-                    while ((c = getNextChar()) != '\n' && c != EOF);
-                    token->type = TK_COMMENT;
-                    token->lexeme = strdup("%");
-                    token->lineNo = lexerBuffer->lineNo - 1;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                }
-
-                // Follow exact DFA transitions:
-                if (c == '<') {currentState = 22;  
-                //goto case_22;
-                }     // Less than branch
-                else if (c == '>') currentState = 30;  // Greater than branch
-                else if (c == '=') currentState = 20;  // Equals branch
-                else if (c == '!') currentState = 21;  // Not equals branch
-                else if (c == '&') currentState = 68;  // AND operator
-                else if (c == '@') currentState = 37;  // @ for OR operator
-                else if (c == '#') currentState = 33;  // # for record identifiers
-                else if (c == '[') currentState = 41;  // Left square bracket
-                else if (c == ']') currentState = 42;  // Right square bracket
-                else if (c == '_') currentState = 2;  // Function identifier
-                // First, modify the DFA transition in case 1:
-                // else if (c >= 'a' && c <= 'z') {
-                //     if (c >= 'b' && c <= 'd') {
-                //         // Check if it's potentially a keyword starting with 'c'
-                //         if (c == 'c') {
-                //             char nextChar = getNextChar();
-                //             if (nextChar == 'a') { // Potential keyword 'call'
-                //                 retract(1);
-                //                 currentState = 6; // Go to FIELDID path which handles keywords
-                //             } else {
-                //                 retract(1);
-                //                 currentState = 8; // Go to the regular [b-d] identifier path
-                //             }
-                //         } else {
-                //             currentState = 8;  // [b-d] identifiers (non-'c' case)
-                //         }
-                //     } else if (c >= 'a' && c <= 'z') {
-                //         currentState = 6;  // Field identifiers and other identifiers
-                //     }
-                //     break;
-                // }
-                // Modified DFA transition in case 1 to handle both 'call' and 'chemistry'
-
-
-                // // Fix compliant with exact language specifications
-                // else if (c >= 'a' && c <= 'z') {
-                //     if (c >= 'b' && c <= 'd') {
-                //         // Special case for 'c' - check next character
-                //         if (c == 'c') {
-                //             // Peek at the next character
-                //             char nextChar = getNextChar();
-                //             // If next char is in range [2-7], treat as TK_ID pattern
-                //             if (nextChar >= '2' && nextChar <= '7') {
-                //                 retract(1);
-                //                 currentState = 8;  // Regular identifier path for TK_ID
-                //             } 
-                //             // Otherwise, route to keyword/field ID path
-                //             else {
-                //                 retract(1);
-                //                 currentState = 6;  // FIELDID/keyword path
-                //             }
-                //         } else {
-                //             currentState = 8;  // Regular [b-d] identifier path
-                //         }
-                //     } else if (c >= 'a' && c <= 'z') {
-                //         currentState = 6;  // Field identifiers and other identifiers
-                //     }
-                //     break;
-                // }
-
-
-                // Complete fix for handling words starting with b, c, and d
-                else if (c >= 'a' && c <= 'z') {
-                    if (c >= 'b' && c <= 'd') {
-                        // Special handling for b, c, d characters which could be either keywords or identifiers
-                        char nextChar = getNextChar();
-                        
-                        // For 'b' - check for keywords like "base", "beginpoint"
-                        if (c == 'b') {
-                            // If it's a letter, likely a keyword or field identifier, not an ID token
-                            if ((nextChar >= 'a' && nextChar <= 'z') || nextChar == EOF || nextChar == '\n') {
-                                retract(1);
-                                currentState = 6;  // Route to FIELDID/keyword path
-                            }
-                            // If it's a valid digit for ID pattern, go to ID path
-                            else if (nextChar >= '2' && nextChar <= '7') {
-                                retract(1);
-                                currentState = 8;  // Regular identifier path
-                            }
-                            // Default fallback
-                            else {
-                                retract(1);
-                                currentState = 6;  // Default to FIELDID path
-                            }
-                        }
-                        // For 'c' - check for keywords like "call"
-                        else if (c == 'c') {
-                            // If it's a letter, likely a keyword or field identifier, not an ID token
-                            if ((nextChar >= 'a' && nextChar <= 'z') || nextChar == EOF || nextChar == '\n') {
-                                retract(1);
-                                currentState = 6;  // Route to FIELDID/keyword path
-                            }
-                            // If it's a valid digit for ID pattern, go to ID path
-                            else if (nextChar >= '2' && nextChar <= '7') {
-                                retract(1);
-                                currentState = 8;  // Regular identifier path
-                            }
-                            // Default fallback
-                            else {
-                                retract(1);
-                                currentState = 6;  // Default to FIELDID path
-                            }
-                        }
-                        // For 'd' - check for keywords like "definetype"
-                        else if (c == 'd') {
-                            // If it's a letter, likely a keyword or field identifier, not an ID token
-                            if ((nextChar >= 'a' && nextChar <= 'z') || nextChar == EOF || nextChar == '\n') {
-                                retract(1);
-                                currentState = 6;  // Route to FIELDID/keyword path
-                            }
-                            // If it's a valid digit for ID pattern, go to ID path
-                            else if (nextChar >= '2' && nextChar <= '7') {
-                                retract(1);
-                                currentState = 8;  // Regular identifier path
-                            }
-                            // Default fallback
-                            else {
-                                retract(1);
-                                currentState = 6;  // Default to FIELDID path
-                            }
-                        }
-                    } else if (c >= 'a' && c <= 'z') {
-                        currentState = 6;  // Field identifiers and other identifiers
-                    }
-                    break;
-                }
-
-                else if (isdigit(c)) {
-                    numBuffer[numLen++] = c;
-                    currentState = 43;  // Number recognition
-                }
-                else {
-                    // Single character tokens matching DFA leaves (12-15 in DFA)
-                    switch (c) {
-                        case '+':
-                            token->type = TK_PLUS;
-                            token->lexeme = strdup("+");
-                            break;
-                        case '-':
-                            token->type = TK_MINUS;
-                            token->lexeme = strdup("-");
-                            break;
-                        case '*':
-                            token->type = TK_MUL;
-                            token->lexeme = strdup("*");
-                            break;
-                        case '/':
-                            token->type = TK_DIV;
-                            token->lexeme = strdup("/");
-                            break;
-                        case '(':
-                            token->type = TK_OP;
-                            token->lexeme = strdup("(");
-                            break;
-                        case ')':
-                            token->type = TK_CL;
-                            token->lexeme = strdup(")");
-                            break;
-                        case ',':
-                            token->type = TK_COMMA;
-                            token->lexeme = strdup(",");
-                            break;
-                        case ';':
-                            token->type = TK_SEM;
-                            token->lexeme = strdup(";");
-                            break;
-                        case ':':
-                            token->type = TK_COLON;
-                            token->lexeme = strdup(":");
-                            break;
-                        case '.':
-                            token->type = TK_DOT;
-                            token->lexeme = strdup(".");
-                            break;
-                        case '~':
-                            token->type = TK_NOT;
-                            token->lexeme = strdup("~");
-                            break;
-                        default:
-                            token->type = TK_ERROR;
-                            token->lexeme = (char*)malloc(2);
-                            token->lexeme[0] = c;
-                            token->lexeme[1] = '\0';
-                            token->errorType = 2;  // Unknown symbol
-
-                        
-                    }
-                    token->lineNo = lexerBuffer->lineNo;
-                     
-                    lexerBuffer->begin = lexerBuffer->forward;                    
-
-                    return token;
-                }
-                break;
-
-            case 2: // Function identifier (starts with _)
-                c = getNextChar();
-                if (isalpha(c)) {
-                    currentState = 3;  // Move to function ID part
-                } else {
-                    token->type = TK_ERROR;
-                    token->lexeme = getLexeme();
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 3;
-                    return token;
-                }
-                break;
-
-            case 3: // Function identifier continued (matches DFA)
-                if (isalnum(c)) {
-                    continue;  // Keep accumulating alphanumeric chars
-                } else {
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    
-                    // Special handling for _main as shown in DFA
-                    if (strcmp(lexeme, "_main") == 0) {
-                        token->type = TK_MAIN;
-                    } else {
-                        // Check function ID length
-                        if (strlen(lexeme) > MAX_FUNID_LEN) {
-                            token->type = TK_ERROR;
-                            token->errorType = 1;  // Length error
-                        } else {
-                            token->type = TK_FUNID;
-                        }
-                    }
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                }
-                break;
+    if (numCheckpoints == checkpointCapacity) {
+        checkpointCapacity = checkpointCapacity ? checkpointCapacity * 2 : 64;
+        checkpoints = (LexerCheckpoint*)realloc(checkpoints, checkpointCapacity * sizeof(LexerCheckpoint));
+    }
+    checkpoints[numCheckpoints].offset = offset;
+    checkpoints[numCheckpoints].lineNo = lexerBuffer->lineNo;
+    checkpoints[numCheckpoints].state = LEX_START;
+    numCheckpoints++;
+    nextCheckpoint = (offset / checkpointInterval + 1) * checkpointInterval;
+}
 
-            case 4: // Function identifier with numbers
-                if (isdigit(c)) {
-                    continue;  // Stay in state 49 as per DFA
-                } else {
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    if (strlen(lexeme) > MAX_FUNID_LEN) {
-                        token->type = TK_ERROR;
-                        token->lexeme = lexeme;
-                        token->lineNo = lexerBuffer->lineNo;
-                        token->errorType = 1;
-                        return token;
-                    }
-                    token->type = TK_FUNID;
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
+// Record a checkpoint every intervalKB KB of input from now on, 0 turns them off
+void enableLexerCheckpoints(int intervalKB) {
+    checkpointInterval = (long)intervalKB * 1024;
+    numCheckpoints = 0;
+    nextCheckpoint = 0;
+}
 
-            case 6: // First char of FIELDID [a-z]
-                if (c >= 'a' && c <= 'z') {
-                    currentState = 7;  // Continue FIELDID path
-                } else {
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    TokenType keywordType = lookupKeyword(keywordTable, lexeme);
-                    if (keywordType != TK_ID) {
-                        token->type = keywordType;  // It's a keyword
-                    } else {
-                        token->type = TK_FIELDID;   // Not a keyword, so it's a FIELDID
-                    }
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
-            
-            case 7: // Rest of FIELDID [a-z]*
-                if (c >= 'a' && c <= 'z') {
-                    currentState = 7;  // Stay in state 7 for more lowercase letters
-                } else {
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    TokenType keywordType = lookupKeyword(keywordTable, lexeme);
-                    if (keywordType != TK_ID) {
-                        token->type = keywordType;  // It's a keyword
-                    } else {
-                        token->type = TK_FIELDID;   // Not a keyword, so it's a FIELDID
-                    }
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
-            
-            case 8: // First char of TK_ID [b-d]
-                if (c >= '2' && c <= '7') {
-                    currentState = 9;
-                } else {
-                    retract(1);
-                    token->type = TK_ERROR;
-                    token->lexeme = getLexeme();
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 3;
-                    return token;
-                }
-                break;
-            
-            case 9: // After [b-d][2-7] for TK_ID
-                if ((c >= 'b' && c <= 'd')){ //|| (c >= '2' && c <= '7')) {
-                    currentState = 10;
-                } 
-                else if ((c>='2'&&c<='7')){
-                    currentState=11;
-                }else {
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    if (strlen(lexeme) > MAX_ID_LEN) {
-                        token->type = TK_ERROR;
-                        token->errorType = 1;  // Length error
-                    } else {
-                        token->type = TK_ID;
-                    }
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
-            
-            case 10: // Rest of TK_ID [b-d2-7]*
-                if ((c >= 'b' && c <= 'd')){ //|| (c >= '2' && c <= '7')) {
-                    currentState = 10;  // Stay in state 10 for [b-d2-7]*
-                }
-                else if ((c>='2'&&c<='7')){
-                    currentState=11;
-                } else {
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    if (strlen(lexeme) > MAX_ID_LEN) {
-                        token->type = TK_ERROR;
-                        token->errorType = 1;  // Length error
-                    } else {
-                        token->type = TK_ID;
-                    }
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
+int getLexerCheckpoints(const LexerCheckpoint** list) {
+    *list = checkpoints;
+    return numCheckpoints;
+}
 
-            case 11:
-                if ((c >= '2' && c <= '7')){ 
-                    currentState = 11;  // Stay in state 10 for [b-d2-7]*
-                }
-                else{
-                    retract(1);
-                    char* lexeme = getLexeme();
-                    if(strlen(lexeme)>MAX_ID_LEN){
-                        token->type = TK_ERROR;
-                        token->errorType = 1;
-                    } else {
-                        token->type = TK_ID;
-                    }
-                    token->lexeme = lexeme;
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
+// Last checkpoint at or before offset, NULL if there is none
+const LexerCheckpoint* findLexerCheckpoint(long offset) {
+    int lo = 0, hi = numCheckpoints - 1;
+    const LexerCheckpoint* found = NULL;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (checkpoints[mid].offset <= offset) {
+            found = &checkpoints[mid];
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return found;
+}
 
-            // case 20: // Equals state
-            //     //c = getNextChar();
-            //     if (c == '=') {
-            //         token->type = TK_EQ;
-            //         token->lexeme = strdup("==");
-            //         token->lineNo = lexerBuffer->lineNo;
-            //         lexerBuffer->begin = lexerBuffer->forward;
-            //         return token;
-            //     }
-            //     token->type = TK_ERROR;
-            //     token->lexeme = strdup("=");
-            //     token->lineNo = lexerBuffer->lineNo;
-            //     token->errorType = 2;
-            //     retract(2);
-            //     return token;
+// Byte offset of the next character the lexer will read
+long getLexerOffset(void) {
+    return lexerBuffer->startOffset + lexerBuffer->forward;
+}
 
-            // case 21: // Not equals state
-            //     //c = getNextChar();
-            //     if (c == '=') {
-            //         token->type = TK_NE;
-            //         token->lexeme = strdup("!=");
-            //         token->lineNo = lexerBuffer->lineNo;
-            //         lexerBuffer->begin = lexerBuffer->forward;
-            //         return token;
-            //     }
-            //     retract(1);
-            //     token->type = TK_ERROR;
-            //     token->lexeme = strdup("!");
-            //     token->lineNo = lexerBuffer->lineNo;
-            //     token->errorType = 2;
-            //     return token;
+// Restart lexing at a checkpoint. The stream has to be seekable.
+int seekLexer(const LexerCheckpoint* checkpoint) {
+    if (lexerBuffer == NULL || lexerBuffer->fp == NULL || checkpoint->state != LEX_START) {
+        return -1;
+    }
+    if (fseek(lexerBuffer->fp, checkpoint->offset, SEEK_SET) != 0) {
+        printf("Error: Cannot seek to offset %ld\n", checkpoint->offset);
+        return -1;
+    }
+    
+    lexerBuffer->length = 0;
+    lexerBuffer->startOffset = checkpoint->offset;
+    lexerBuffer->forward = 0;
+    lexerBuffer->begin = 0;
+    lexerBuffer->lineNo = checkpoint->lineNo;
+    lexerBuffer->eof = 0;
+    
+    getStream(lexerBuffer->fp);
+    return 0;
+}
 
-            // case_22:
-            // case 22: // Detect `<`
-            //     c = getNextChar();
-            //     if (c == '-')
-            //     {
-            //         c = getNextChar();
-            //         if (c == '-')
-            //         {
-            //             c = getNextChar();
-            //             if (c == '-')
-            //             {
-            //                 // ✅ Successfully found `<---`
-            //                 token->type = TK_ASSIGNOP;
-            //                 token->lexeme = strdup("<---");
-            //                 token->lineNo = lexerBuffer->lineNo;
-            //                 lexerBuffer->begin = lexerBuffer->forward;
-            //                 return token;
-            //             }
-            //             // ❌ Found `<--` but no third `-`, retract 2 and return `<`
-            //             retract(2);
-            //         }
-            //         else
-            //         {
-            //             // ❌ Found `<-` but no second `-`, retract 1 and return `<`
-            //             retract(1);
-            //         }
-            //     }
-            //     else if (c == '=')
-            //     {
-            //         // ✅ Successfully found `<=`
-            //         token->type = TK_LE;
-            //         token->lexeme = strdup("<=");
-            //         token->lineNo = lexerBuffer->lineNo;
-            //         lexerBuffer->begin = lexerBuffer->forward;
-            //         return token;
-            //     }
-            //     else
-            //     {
-            //         // If none of the above matched, return `<` alone.
-            //         retract(1);
-            //     }
-            //     lexerBuffer->begin = lexerBuffer->forward;
-            //     token->type = TK_LT;
-            //     token->lexeme = strdup("<");
-            //     token->lineNo = lexerBuffer->lineNo;
-            //     return token;
+// Create a lexer that is handed its input with lexerFeed instead of reading a file
+LexerContext* createPushLexer(void) {
+    LexerBuffer* lexer = (LexerBuffer*)malloc(sizeof(LexerBuffer));
+    lexer->capacity = 2 * BUFFER_SIZE;
+    lexer->buffer = (char*)malloc(lexer->capacity);
+    lexer->buffer[0] = LEX_SENTINEL;
+    lexer->length = 0;
+    lexer->startOffset = 0;
+    lexer->fp = NULL;
+    lexer->forward = 0;
+    lexer->begin = 0;
+    lexer->lineNo = 1;
+    lexer->eof = 0;
+    lexer->starved = 0;
+    return lexer;
+}
 
-            case 20: // Equals state
-                //c = getNextChar();
-                if (c == '=') {
-                    token->type = TK_EQ;
-                    token->lexeme = strdup("==");
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                }
-                token->type = TK_ERROR;
-                token->lexeme = strdup("=");
-                token->lineNo = lexerBuffer->lineNo;
-                token->errorType = 2;
-                retract(1);
-                return token;
+void freePushLexer(LexerContext* ctx) {
+    free(ctx->buffer);
+    free(ctx);
+}
 
-            case 21: // Not equals state
-                //c = getNextChar();
-                if (c == '=') {
-                    token->type = TK_NE;
-                    token->lexeme = strdup("!=");
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                }
-                retract(1);
-                token->type = TK_ERROR;
-                token->lexeme = strdup("!");
-                token->lineNo = lexerBuffer->lineNo;
-                token->errorType = 2;
-                return token;
+// Append n bytes of input and lex as far as they go. Returns the tokens completed so far
+// (an array the caller frees along with the tokens) and sets numTokens. A token that
+// still runs into the end of the bytes is not returned yet: the lexer rewinds to where it
+// started and matches it again once the next chunk arrives. Feeding n == 0 marks the end
+// of the input and flushes the last token.
+Token** lexerFeed(LexerContext* ctx, const char* bytes, int n, int* numTokens) {
+    LexerBuffer* saved = lexerBuffer;
+    lexerBuffer = ctx;
+    
+    if (n > 0) {
+        slideWindow(n);
+        memcpy(lexerBuffer->buffer + lexerBuffer->length, bytes, n);
+        lexerBuffer->length += n;
+        lexerBuffer->buffer[lexerBuffer->length] = LEX_SENTINEL;
+    } else {
+        lexerBuffer->eof = 1;
+    }
+    
+    Token** tokens = NULL;
+    int count = 0, capacity = 0;
+    while (1) {
+        int start = lexerBuffer->forward;
+        int startLine = lexerBuffer->lineNo;
+        lexerBuffer->starved = 0;
+        Token* token = getNextToken();
+        
+        if (lexerBuffer->starved) {
+            if (token != NULL) {
+                free(token->lexeme);
+                free(token);
+            }
+            lexerBuffer->forward = start;
+            lexerBuffer->begin = start;
+            lexerBuffer->lineNo = startLine;
+            break;
+        }
+        if (token == NULL) {
+            break;
+        }
+        
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            tokens = (Token**)realloc(tokens, capacity * sizeof(Token*));
+        }
+        tokens[count++] = token;
+    }
+    
+    lexerBuffer = saved;
+    *numTokens = count;
+    return tokens;
+}
 
-            case 22: // Less than state
-                //c = getNextChar();
-                if (c == '-') {
-                    currentState = 24;  // Start of assignment operator
-                } else if (c == '=') {
-                    token->type = TK_LE;
-                    token->lexeme = strdup("<=");
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                } else {
-                    retract(1);
-                    token->type = TK_LT;
-                    token->lexeme = strdup("<");
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
 
-            case 24: // First - of assignment
-                //c = getNextChar();
-                if (c == '-') {
-                    currentState = 25;
-                } else {
-                    retract(2);
-                    token->type = TK_LT;
-                    token->lexeme = strdup("<");
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
+// Match the longest token from the current position with the tables generated from
+// lexer_spec.txt, then apply its action. The DFA only peeks ahead of forward, which moves
+// once, to the end of the longest match, so nothing is ever retracted. States that loop
+// over a run of bytes skip the run with scanLoop instead of stepping through the table.
+// The sentinel after the window stops the DFA like any byte it has no transition on, so
+// the end of the window is only checked for once the DFA has stopped on LEX_SENTINEL.
+Token* getNextToken(void) {
+    // Checkpoints belong to the file-backed lexer; a push lexer cannot seek
+    if (checkpointInterval > 0 && lexerBuffer->fp != NULL) {
+        recordCheckpoint();
+    }
+    
+    while (1) {
+        int newlines = 0;
+        lexerBuffer->forward = skipSpaces(lexerBuffer->buffer, lexerBuffer->forward,
+                                          lexerBuffer->length, &newlines);
+        lexerBuffer->lineNo += newlines;
+        lexerBuffer->begin = lexerBuffer->forward;
+        
+        // Lookahead is counted from forward, which a refill may move
+        int state = LEX_START;
+        int action = -1;
+        int acceptLength = 0, acceptLines = 0;
+        int k = 0, lines = 0;
+        while (1) {
+            unsigned char c = lexerBuffer->buffer[lexerBuffer->forward + k];
+            int next = lexTransitions[state][lexClass[c]];
+            if (next == LEX_DEAD) {
+                if (c != LEX_SENTINEL) {
+                    break;
                 }
-                break;
-
-            case 25:
-                //c = getNextChar();
-                    if (c == '-') {
-                        token->type = TK_ASSIGNOP;
-                        token->lexeme = strdup("<---");
-                        token->lineNo = lexerBuffer->lineNo;
-                        lexerBuffer->begin = lexerBuffer->forward;
-                        return token;
-                    }
-                    else {
-                        retract(3);
-                        token->type=TK_LT;
-                        token->lexeme = strdup("<");
-                        token->lineNo = lexerBuffer->lineNo;
-                        lexerBuffer->begin = lexerBuffer->forward; 
-                        return token;
+                if (lexerBuffer->forward + k < lexerBuffer->length) {
+                    next = lexSentinelNext[state];  // the byte is part of the input
+                    if (next == LEX_DEAD) {
+                        break;
                     }
+                } else if (peekChar(k) == EOF) {
                     break;
-                
-
-            // case 26: // Second - of assignment
-            //     c = getNextChar();
-            //     if (c == '-') {
-            //         token->type = TK_ASSIGNOP;
-            //         token->lexeme = strdup("<---");
-            //         token->lineNo = lexerBuffer->lineNo;
-            //         lexerBuffer->begin = lexerBuffer->forward;
-            //         return token;
-            //     }
-            //     retract(3);
-            //     token->type = TK_LT;
-            //     token->lexeme = strdup("<");
-            //     token->lineNo = lexerBuffer->lineNo;
-            //     return token;
-
-            case 30: // Greater than state
-                //c = getNextChar();
-                if (c == '=') {
-                    token->type = TK_GE;
-                    token->lexeme = strdup(">=");
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                }
-                retract(1);
-                token->type = TK_GT;
-                token->lexeme = strdup(">");
-                token->lineNo = lexerBuffer->lineNo;
-                return token;
-
-            case 33: // # state - start of record id
-                if (isalpha(c) && islower(c)) {
-                    numBuffer[numLen++] = '#';
-                    numBuffer[numLen++] = c;
-                    currentState = 35;
                 } else {
-                    token->type = TK_ERROR;
-                    token->lexeme = strdup("#");
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 3;  // Unknown pattern
-                    return token;
+                    continue;  // refilled, read the byte there now
                 }
-                break;
-            
-            case 35: // Rest of record identifier [a-z]*
-                if (isalpha(c) && islower(c)) {
-                    numBuffer[numLen++] = c;
-                    continue;
-                } else {
-                    retract(1);
-                    numBuffer[numLen] = '\0';
-                    token->type = TK_RUID;  // Changed from TK_RECORDID to TK_RUID
-                    token->lexeme = strdup(numBuffer);
-                    token->lineNo = lexerBuffer->lineNo;
-                    numLen = 0;  // Reset numBuffer
-                    return token;
-                }
-                break;
-    
+            }
+            state = next;
+            k++;
+            if (c == '\n') {
+                lines++;
+            }
+            if (lexLoop[state].numRanges) {
+                k = scanLoop(lexerBuffer->buffer, lexerBuffer->forward + k, lexerBuffer->length,
+                             &lexLoop[state]) - lexerBuffer->forward;
+            }
+            if (lexAccept[state] >= 0) {
+                action = lexAccept[state];
+                acceptLength = k;
+                acceptLines = lines;
+            }
+        }
+        lexerBuffer->forward += acceptLength;
+        lexerBuffer->lineNo += acceptLines;
+        
+        if (action < 0) {
+            return NULL;  // end of input
+        }
+        if (action == LEX_SKIP) {
+            continue;
+        }
+        
+        Token* token = (Token*)malloc(sizeof(Token));
+        int c;
+        switch (action) {
+            case LEX_COMMENT:
+                do {
+                    // Jump to the newline, or to the end of the window and refill
+                    lexerBuffer->forward = findNewline(lexerBuffer->buffer, lexerBuffer->forward,
+                                                       lexerBuffer->length);
+                    lexerBuffer->begin = lexerBuffer->forward;  // Nothing of a comment is kept
+                } while ((c = getNextChar()) != '\n' && c != EOF);
+                token->type = TK_COMMENT;
+                token->lexeme = strdup("%");
+                token->lineNo = lexerBuffer->lineNo - 1;
+                lexerBuffer->begin = lexerBuffer->forward;
+                return token;
             
-
-            case 37: // @ state
-                c = getNextChar();
-                if (c == '@') {
-                    currentState = 38;
-                } else {
-                    token->type = TK_ERROR;
-                    token->lexeme = strdup("@");
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 2;
-                    return token;
-                }
-                break;
-
-            case 38: // @@ state
-                c = getNextChar();
-                if (c == '@') {
-                    token->type = TK_OR;
-                    token->lexeme = strdup("@@@");
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
+            case LEX_UNKNOWN_SYMBOL:
                 token->type = TK_ERROR;
-                token->lexeme = strdup("@@");
-                token->lineNo = lexerBuffer->lineNo;
                 token->errorType = 2;
-                return token;
-
-            
-            case 41: // [ state from DFA
-                token->type = TK_SQL;
-                token->lexeme = strdup("[");
-                token->lineNo = lexerBuffer->lineNo;
-                retract(1);  
-                return token;
-
-            case 42: // ] state from DFA
-                token->type = TK_SQR;
-                token->lexeme = strdup("]");
-                token->lineNo = lexerBuffer->lineNo;
-                retract(1);  
-                return token;
-
-            case 43: // Number start state 
-                if (isdigit(c)) {
-                    numBuffer[numLen++] = c;
-                }
-                else if (c == '.') {
-                    numBuffer[numLen++] = c;
-                    currentState = 46;  // Move to decimal point state
-                }
-                else {
-                    retract(1);
-                    token->type = TK_NUM;
-                    token->lexeme = strdup(numBuffer);
-                    token->value.numValue = atoi(numBuffer);
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
-                break;
-
-            case 46: // First decimal digit state
-                if (isdigit(c)) {
-                    numBuffer[numLen++] = c;
-                    currentState = 47;  // Move to second decimal digit state
-                }
-                else {
-                    token->type = TK_ERROR;
-                    token->lexeme = strdup(numBuffer);
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 3;  // Unknown pattern
-                    return token;
-                }
-                break;
-
-            case 47: // Second decimal digit state
-                if (isdigit(c)) {
-                    numBuffer[numLen++] = c;
-                    currentState = 48;  // New state to check for E/e or end
-                }
-                else {
-                    token->type = TK_ERROR;
-                    token->lexeme = strdup(numBuffer);
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 3;  // Unknown pattern
-                    retract(1);
-                    return token;
-                }
                 break;
             
-            case 48: // After two decimal places
-                if (c == 'E' || c == 'e') {
-                    numBuffer[numLen++] = c;
-                    c = getNextChar();
-                    if (c == '+' || c == '-') {
-                        numBuffer[numLen++] = c;
-                        //c = getNextChar();  // Read first exponent digit after sign
-                    }
-                    currentState = 52;  // Move to exponent state
-                } else {
-                    retract(1);
-                    token->type = TK_RNUM;
-                    token->lexeme = strdup(numBuffer);
-                    token->value.realValue = atof(numBuffer);
-                    token->lineNo = lexerBuffer->lineNo;
-                    return token;
-                }
+            case LEX_UNKNOWN_PATTERN:
+                token->type = TK_ERROR;
+                token->errorType = 3;
                 break;
             
-    
-
-            case 50: // Real number state (matches DFA)
-                retract(1);
-                token->type = TK_RNUM;
-                token->lexeme = strdup(numBuffer);
-                token->value.realValue = atof(numBuffer);
-                token->lineNo = lexerBuffer->lineNo;
-                return token;
-
-            case 51: // Error state for real numbers (shown with * in DFA)
-                token->type = TK_ERROR;
-                token->lexeme = strdup(numBuffer);
-                token->lineNo = lexerBuffer->lineNo;
-                token->errorType = 3;  // Unknown pattern
-                return token;
-
-            case 52: { // Exponent part
-                    int exponentDigits = 0;
-                    if (!isdigit(c)) {
-                        token->type = TK_ERROR;
-                        token->lexeme = strdup(numBuffer);
-                        token->lineNo = lexerBuffer->lineNo;
-                        token->errorType = 3;
-                        return token;
-                    }
-                    // Loop to accept exactly 2 digits
-                    while (isdigit(c) && exponentDigits < 2) {
-                        numBuffer[numLen++] = c;
-                        c = getNextChar();
-                        exponentDigits++;
-                    }
-                    
-                    // If more than 2 digits, retract and stop processing exponent
-                    retract(1);
-    
-                    // Finalize the token
-                    numBuffer[numLen] = '\0';
-                    token->type = TK_RNUM;
-                    token->lexeme = strdup(numBuffer);
-                    token->value.realValue = atof(numBuffer);
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;
-                    return token;
-                }
-                
-
-            case 68: // First & state
-                if (c == '&') {
-                    currentState = 69;
-                } else {
-                    retract(1);
+            case TK_ID:
+                token->type = TK_ID;
+                if (acceptLength > MAX_ID_LEN) {
                     token->type = TK_ERROR;
-                    token->lexeme = strdup("&");
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 2;  // Unknown symbol
-                    lexerBuffer->begin = lexerBuffer->forward;  // Ensure begin is updated
-                    return token;
+                    token->errorType = 1;  // Length error
                 }
                 break;
             
-            case 69: // && state
-                if (c == '&') {
-                    token->type = TK_AND;
-                    token->lexeme = strdup("&&&");
-                    token->lineNo = lexerBuffer->lineNo;
-                    lexerBuffer->begin = lexerBuffer->forward;  // Ensure begin is updated
-                    return token;
-                } else {
-                    retract(1);
+            case TK_FUNID:
+                token->type = TK_FUNID;
+                if (acceptLength > MAX_FUNID_LEN) {
                     token->type = TK_ERROR;
-                    token->lexeme = strdup("&&");
-                    token->lineNo = lexerBuffer->lineNo;
-                    token->errorType = 3;  // Unknown pattern
-                    lexerBuffer->begin = lexerBuffer->forward;  // Ensure begin is updated for next token
-                    return token;
+                    token->errorType = 1;  // Length error
                 }
                 break;
             
-            default: // Error state (shown with * in DFA)
-                token->type = TK_ERROR;
-                token->lexeme = getLexeme();
-                token->lineNo = lexerBuffer->lineNo;
-                token->errorType = 3;  // Unknown pattern
-                return token;
+            default:
+                token->type = (TokenType)action;
+                break;
+        }
+        
+        token->lexeme = getLexeme();
+        token->lineNo = lexerBuffer->lineNo;
+        if (token->type == TK_NUM) {
+            token->value.numValue = atoi(token->lexeme);
+        } else if (token->type == TK_RNUM) {
+            token->value.realValue = atof(token->lexeme);
         }
+        lexerBuffer->begin = lexerBuffer->forward;
+        return token;
     }
 }
 
@@ -998,7 +573,7 @@ void removeComments(char* inputFile, char* cleanFile) {
         return;
     }
     
-    char c;
+    int c;
     int inComment = 0;
     
     while ((c = fgetc(in)) != EOF) {
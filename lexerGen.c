@@ -0,0 +1,796 @@
+// Lexer generator: reads a token specification (see lexer_spec.txt), builds an NFA for the
+// rules, turns it into a DFA over byte equivalence classes, minimizes it and writes the
+// transition and accept tables as a C header for lexerFinal1.c.
+//
+//     gcc -o lexerGen lexerGen.c && ./lexerGen lexer_spec.txt lexer_tables.h
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#define MAX_RULES 128
+#define MAX_NAME_LEN 32
+#define MAX_LINE_LEN 1024
+#define MAX_NFA_STATES 16384
+#define MAX_CHARSETS 2048
+#define MAX_DFA_STATES 4096
+#define MAX_LOOP_RANGES 3
+
+// Byte the runtime keeps after the last valid input byte; see splitSentinel
+#define LEX_SENTINEL 0x00
+
+typedef struct {
+    unsigned char bits[32];
+} ByteSet;
+
+// An NFA state either has a byte edge (charset >= 0) to out, or up to two epsilon edges
+typedef struct {
+    int charset;
+    int out;
+    int out2;
+    int accept;  // rule index, -1 if not accepting
+} NfaState;
+
+typedef struct {
+    int start;
+    int end;     // always a fresh state with no edges yet
+} Fragment;
+
+typedef struct {
+    char name[MAX_NAME_LEN];
+    char pattern[MAX_LINE_LEN];
+    int lineNo;
+} Rule;
+
+typedef struct {
+    Rule rules[MAX_RULES];
+    int numRules;
+
+    NfaState* nfa;
+    int numNfa;
+    ByteSet* charsets;
+    int numCharsets;
+
+    int classOf[256];
+    int numClasses;
+
+    int numDfa;
+    int* transitions;   // numDfa x numClasses, state 0 is the dead state
+    int* accept;        // rule index per DFA state, -1 if not accepting
+    int start;
+    int* sentinelNext;  // per DFA state, where a real LEX_SENTINEL byte in the input leads
+} LexerGen;
+
+// Regular expression parser state
+typedef struct {
+    LexerGen* gen;
+    const char* p;
+    const Rule* rule;
+    bool failed;
+} RegexParser;
+
+static void setByte(ByteSet* set, int b) {
+    set->bits[b >> 3] |= (unsigned char)(1 << (b & 7));
+}
+
+static bool hasByte(const ByteSet* set, int b) {
+    return (set->bits[b >> 3] >> (b & 7)) & 1;
+}
+
+static int newNfaState(LexerGen* gen) {
+    if (gen->numNfa == MAX_NFA_STATES) {
+        printf("Error: more than %d NFA states\n", MAX_NFA_STATES);
+        exit(1);
+    }
+    NfaState* state = &gen->nfa[gen->numNfa];
+    state->charset = -1;
+    state->out = -1;
+    state->out2 = -1;
+    state->accept = -1;
+    return gen->numNfa++;
+}
+
+static int newCharset(LexerGen* gen) {
+    if (gen->numCharsets == MAX_CHARSETS) {
+        printf("Error: more than %d character sets\n", MAX_CHARSETS);
+        exit(1);
+    }
+    memset(&gen->charsets[gen->numCharsets], 0, sizeof(ByteSet));
+    return gen->numCharsets++;
+}
+
+static void regexError(RegexParser* parser, const char* message) {
+    if (!parser->failed) {
+        printf("Error: line %d, rule %s: %s near \"%s\"\n", parser->rule->lineNo,
+               parser->rule->name, message, parser->p);
+    }
+    parser->failed = true;
+}
+
+static Fragment charsetFragment(LexerGen* gen, int charset) {
+    Fragment frag;
+    frag.start = newNfaState(gen);
+    frag.end = newNfaState(gen);
+    gen->nfa[frag.start].charset = charset;
+    gen->nfa[frag.start].out = frag.end;
+    return frag;
+}
+
+static Fragment emptyFragment(LexerGen* gen) {
+    Fragment frag;
+    frag.start = newNfaState(gen);
+    frag.end = newNfaState(gen);
+    gen->nfa[frag.start].out = frag.end;
+    return frag;
+}
+
+// Read one possibly escaped byte
+static int parseByte(RegexParser* parser) {
+    unsigned char c = (unsigned char)*parser->p++;
+    if (c != '\\') {
+        return c;
+    }
+    c = (unsigned char)*parser->p++;
+    switch (c) {
+        case 't': return '\t';
+        case 'n': return '\n';
+        case 'v': return '\v';
+        case 'f': return '\f';
+        case 'r': return '\r';
+        case 'x': {
+            int value = 0;
+            for (int i = 0; i < 2; i++) {
+                char h = *parser->p;
+                int digit;
+                if (h >= '0' && h <= '9') digit = h - '0';
+                else if (h >= 'a' && h <= 'f') digit = h - 'a' + 10;
+                else if (h >= 'A' && h <= 'F') digit = h - 'A' + 10;
+                else {
+                    regexError(parser, "bad \\x escape");
+                    return 0;
+                }
+                value = value * 16 + digit;
+                parser->p++;
+            }
+            return value;
+        }
+        case '\0':
+            parser->p--;
+            regexError(parser, "dangling backslash");
+            return 0;
+        default:
+            return c;
+    }
+}
+
+static Fragment parseAlternation(RegexParser* parser);
+
+// [abc], [a-z], [^\n]
+static Fragment parseClass(RegexParser* parser) {
+    LexerGen* gen = parser->gen;
+    int charset = newCharset(gen);
+    bool negate = false;
+
+    parser->p++;  // [
+    if (*parser->p == '^') {
+        negate = true;
+        parser->p++;
+    }
+    while (*parser->p != ']') {
+        if (*parser->p == '\0') {
+            regexError(parser, "unterminated [");
+            break;
+        }
+        int lo = parseByte(parser);
+        int hi = lo;
+        if (parser->p[0] == '-' && parser->p[1] != ']' && parser->p[1] != '\0') {
+            parser->p++;
+            hi = parseByte(parser);
+        }
+        if (hi < lo) {
+            regexError(parser, "empty range");
+        }
+        for (int b = lo; b <= hi; b++) {
+            setByte(&gen->charsets[charset], b);
+        }
+    }
+    if (*parser->p == ']') {
+        parser->p++;
+    }
+    if (negate) {
+        for (int i = 0; i < 32; i++) {
+            gen->charsets[charset].bits[i] = (unsigned char)~gen->charsets[charset].bits[i];
+        }
+    }
+    return charsetFragment(gen, charset);
+}
+
+static Fragment parseAtom(RegexParser* parser) {
+    LexerGen* gen = parser->gen;
+    char c = *parser->p;
+
+    if (c == '(') {
+        parser->p++;
+        Fragment frag = parseAlternation(parser);
+        if (*parser->p != ')') {
+            regexError(parser, "missing )");
+        } else {
+            parser->p++;
+        }
+        return frag;
+    }
+    if (c == '[') {
+        return parseClass(parser);
+    }
+
+    int charset = newCharset(gen);
+    if (c == '.') {
+        parser->p++;
+        memset(&gen->charsets[charset], 0xFF, sizeof(ByteSet));
+    } else {
+        setByte(&gen->charsets[charset], parseByte(parser));
+    }
+    return charsetFragment(gen, charset);
+}
+
+static Fragment parseRepeat(RegexParser* parser) {
+    LexerGen* gen = parser->gen;
+    Fragment frag = parseAtom(parser);
+
+    while (*parser->p == '*' || *parser->p == '+' || *parser->p == '?') {
+        char op = *parser->p++;
+        int start = newNfaState(gen);
+        int end = newNfaState(gen);
+
+        gen->nfa[start].out = frag.start;
+        gen->nfa[frag.end].out = end;
+        if (op == '*' || op == '?') {
+            gen->nfa[start].out2 = end;      // skip
+        }
+        if (op == '*' || op == '+') {
+            gen->nfa[frag.end].out2 = frag.start;  // repeat
+        }
+        frag.start = start;
+        frag.end = end;
+    }
+    return frag;
+}
+
+static Fragment parseConcatenation(RegexParser* parser) {
+    LexerGen* gen = parser->gen;
+    Fragment frag;
+    bool first = true;
+
+    while (*parser->p != '\0' && *parser->p != '|' && *parser->p != ')' && !parser->failed) {
+        if (*parser->p == '*' || *parser->p == '+' || *parser->p == '?') {
+            regexError(parser, "repetition of nothing");
+            break;
+        }
+        Fragment next = parseRepeat(parser);
+        if (first) {
+            frag = next;
+            first = false;
+        } else {
+            gen->nfa[frag.end].out = next.start;
+            frag.end = next.end;
+        }
+    }
+    return first ? emptyFragment(gen) : frag;
+}
+
+static Fragment parseAlternation(RegexParser* parser) {
+    LexerGen* gen = parser->gen;
+    Fragment frag = parseConcatenation(parser);
+
+    while (*parser->p == '|' && !parser->failed) {
+        parser->p++;
+        Fragment other = parseConcatenation(parser);
+        int start = newNfaState(gen);
+        int end = newNfaState(gen);
+        gen->nfa[start].out = frag.start;
+        gen->nfa[start].out2 = other.start;
+        gen->nfa[frag.end].out = end;
+        gen->nfa[other.end].out = end;
+        frag.start = start;
+        frag.end = end;
+    }
+    return frag;
+}
+
+// Rules are "NAME pattern" lines; blank lines and lines starting with # are skipped
+static bool readSpec(LexerGen* gen, const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Cannot open file %s\n", filename);
+        return false;
+    }
+
+    char line[MAX_LINE_LEN];
+    int lineNo = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNo++;
+        size_t len = strlen(line);
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r' ||
+                           line[len - 1] == ' ' || line[len - 1] == '\t')) {
+            line[--len] = '\0';
+        }
+        char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '#') {
+            continue;
+        }
+
+        if (gen->numRules == MAX_RULES) {
+            printf("Error: more than %d rules\n", MAX_RULES);
+            fclose(file);
+            return false;
+        }
+        Rule* rule = &gen->rules[gen->numRules];
+        int n = 0;
+        while (*p != '\0' && *p != ' ' && *p != '\t') {
+            if (n < MAX_NAME_LEN - 1) {
+                rule->name[n++] = *p;
+            }
+            p++;
+        }
+        rule->name[n] = '\0';
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0') {
+            printf("Error: line %d, rule %s has no pattern\n", lineNo, rule->name);
+            fclose(file);
+            return false;
+        }
+        strcpy(rule->pattern, p);
+        rule->lineNo = lineNo;
+        gen->numRules++;
+    }
+
+    fclose(file);
+    return gen->numRules > 0;
+}
+
+// One NFA whose start state has epsilon edges into every rule
+static int buildNfa(LexerGen* gen) {
+    int start = -1;
+
+    for (int r = gen->numRules - 1; r >= 0; r--) {
+        RegexParser parser = { gen, gen->rules[r].pattern, &gen->rules[r], false };
+        Fragment frag = parseAlternation(&parser);
+        if (*parser.p != '\0') {
+            regexError(&parser, "unexpected character");
+        }
+        if (parser.failed) {
+            return -1;
+        }
+        gen->nfa[frag.end].accept = r;
+
+        int fork = newNfaState(gen);
+        gen->nfa[fork].out = frag.start;
+        gen->nfa[fork].out2 = start;
+        start = fork;
+    }
+    return start;
+}
+
+// Bytes that fall in exactly the same character sets are interchangeable
+static void computeByteClasses(LexerGen* gen) {
+    int representative[256];
+    gen->numClasses = 0;
+
+    for (int b = 0; b < 256; b++) {
+        int cls;
+        for (cls = 0; cls < gen->numClasses; cls++) {
+            int r = representative[cls];
+            int s;
+            for (s = 0; s < gen->numCharsets; s++) {
+                if (hasByte(&gen->charsets[s], b) != hasByte(&gen->charsets[s], r)) {
+                    break;
+                }
+            }
+            if (s == gen->numCharsets) {
+                break;
+            }
+        }
+        if (cls == gen->numClasses) {
+            representative[gen->numClasses++] = b;
+        }
+        gen->classOf[b] = cls;
+    }
+}
+
+static void epsilonClosure(LexerGen* gen, unsigned char* set, int* stack) {
+    int top = 0;
+    for (int i = 0; i < gen->numNfa; i++) {
+        if (set[i]) {
+            stack[top++] = i;
+        }
+    }
+    while (top > 0) {
+        NfaState* state = &gen->nfa[stack[--top]];
+        if (state->charset >= 0) {
+            continue;
+        }
+        if (state->out >= 0 && !set[state->out]) {
+            set[state->out] = 1;
+            stack[top++] = state->out;
+        }
+        if (state->out2 >= 0 && !set[state->out2]) {
+            set[state->out2] = 1;
+            stack[top++] = state->out2;
+        }
+    }
+}
+
+// Subset construction; DFA state 0 is the empty set
+static bool buildDfa(LexerGen* gen, int nfaStart) {
+    int n = gen->numNfa;
+    unsigned char* sets = (unsigned char*)calloc((size_t)MAX_DFA_STATES * n, 1);
+    int* stack = (int*)malloc(n * sizeof(int));
+    unsigned char* next = (unsigned char*)malloc(n);
+    int* classByte = (int*)malloc(gen->numClasses * sizeof(int));
+    gen->transitions = (int*)malloc((size_t)MAX_DFA_STATES * gen->numClasses * sizeof(int));
+    gen->accept = (int*)malloc(MAX_DFA_STATES * sizeof(int));
+
+    for (int b = 255; b >= 0; b--) {
+        classByte[gen->classOf[b]] = b;
+    }
+
+    gen->numDfa = 2;
+    sets[n + nfaStart] = 1;
+    epsilonClosure(gen, sets + n, stack);
+    gen->start = 1;
+
+    for (int d = 0; d < gen->numDfa; d++) {
+        unsigned char* set = sets + (size_t)d * n;
+        gen->accept[d] = -1;
+        for (int i = 0; i < n; i++) {
+            if (set[i] && gen->nfa[i].accept >= 0 &&
+                (gen->accept[d] < 0 || gen->nfa[i].accept < gen->accept[d])) {
+                gen->accept[d] = gen->nfa[i].accept;  // earlier rule wins
+            }
+        }
+
+        for (int cls = 0; cls < gen->numClasses; cls++) {
+            memset(next, 0, n);
+            for (int i = 0; i < n; i++) {
+                if (set[i] && gen->nfa[i].charset >= 0 &&
+                    hasByte(&gen->charsets[gen->nfa[i].charset], classByte[cls])) {
+                    next[gen->nfa[i].out] = 1;
+                }
+            }
+            epsilonClosure(gen, next, stack);
+
+            int target;
+            for (target = 0; target < gen->numDfa; target++) {
+                if (memcmp(sets + (size_t)target * n, next, n) == 0) {
+                    break;
+                }
+            }
+            if (target == gen->numDfa) {
+                if (gen->numDfa == MAX_DFA_STATES) {
+                    printf("Error: more than %d DFA states\n", MAX_DFA_STATES);
+                    return false;
+                }
+                memcpy(sets + (size_t)target * n, next, n);
+                gen->numDfa++;
+            }
+            gen->transitions[d * gen->numClasses + cls] = target;
+        }
+    }
+
+    free(sets);
+    free(stack);
+    free(next);
+    free(classByte);
+    return true;
+}
+
+// Moore's partition refinement: start from states grouped by what they accept and split
+// groups until every member of a group moves to the same groups on every class. The dead
+// state ends up as group 0 and the start state as group 1.
+static void minimizeDfa(LexerGen* gen) {
+    int numStates = gen->numDfa;
+    int numClasses = gen->numClasses;
+    int* group = (int*)malloc(numStates * sizeof(int));
+    int* newGroup = (int*)malloc(numStates * sizeof(int));
+    int numGroups = 0;
+
+    for (int s = 0; s < numStates; s++) {
+        group[s] = -1;
+        for (int t = 0; t < s; t++) {
+            if (gen->accept[t] == gen->accept[s]) {
+                group[s] = group[t];
+                break;
+            }
+        }
+        if (group[s] < 0) {
+            group[s] = numGroups++;
+        }
+    }
+
+    while (1) {
+        int count = 0;
+        for (int s = 0; s < numStates; s++) {
+            newGroup[s] = -1;
+            for (int t = 0; t < s; t++) {
+                if (group[t] != group[s]) {
+                    continue;
+                }
+                int cls;
+                for (cls = 0; cls < numClasses; cls++) {
+                    if (group[gen->transitions[s * numClasses + cls]] !=
+                        group[gen->transitions[t * numClasses + cls]]) {
+                        break;
+                    }
+                }
+                if (cls == numClasses) {
+                    newGroup[s] = newGroup[t];
+                    break;
+                }
+            }
+            if (newGroup[s] < 0) {
+                newGroup[s] = count++;
+            }
+        }
+        memcpy(group, newGroup, numStates * sizeof(int));
+        if (count == numGroups) {
+            break;
+        }
+        numGroups = count;
+    }
+
+    // Number the groups breadth first from the dead and start states
+    int* order = (int*)malloc(numGroups * sizeof(int));
+    int* number = (int*)malloc(numGroups * sizeof(int));
+    int* member = (int*)malloc(numGroups * sizeof(int));
+    for (int g = 0; g < numGroups; g++) {
+        number[g] = -1;
+    }
+    for (int s = numStates - 1; s >= 0; s--) {
+        member[group[s]] = s;
+    }
+    int numOrdered = 0;
+    number[group[0]] = numOrdered;
+    order[numOrdered++] = group[0];
+    if (number[group[gen->start]] < 0) {
+        number[group[gen->start]] = numOrdered;
+        order[numOrdered++] = group[gen->start];
+    }
+    for (int i = 0; i < numOrdered; i++) {
+        int s = member[order[i]];
+        for (int cls = 0; cls < numClasses; cls++) {
+            int g = group[gen->transitions[s * numClasses + cls]];
+            if (number[g] < 0) {
+                number[g] = numOrdered;
+                order[numOrdered++] = g;
+            }
+        }
+    }
+
+    int* transitions = (int*)malloc((size_t)numOrdered * numClasses * sizeof(int));
+    int* accept = (int*)malloc(numOrdered * sizeof(int));
+    for (int i = 0; i < numOrdered; i++) {
+        int s = member[order[i]];
+        accept[i] = gen->accept[s];
+        for (int cls = 0; cls < numClasses; cls++) {
+            transitions[i * numClasses + cls] = number[group[gen->transitions[s * numClasses + cls]]];
+        }
+    }
+
+    free(gen->transitions);
+    free(gen->accept);
+    gen->transitions = transitions;
+    gen->accept = accept;
+    gen->numDfa = numOrdered;
+    gen->start = number[group[gen->start]];
+
+    free(group);
+    free(newGroup);
+    free(order);
+    free(number);
+    free(member);
+}
+
+// The sentinel byte has a class of its own (see main). Its column is moved to
+// sentinelNext and replaced by the dead state, so the runtime's DFA loop stops on the
+// sentinel without a bounds check and only then looks at whether it is the end of the
+// buffered input or a real byte to continue with.
+static int splitSentinel(LexerGen* gen) {
+    int cls = gen->classOf[LEX_SENTINEL];
+    gen->sentinelNext = (int*)malloc(gen->numDfa * sizeof(int));
+    for (int s = 0; s < gen->numDfa; s++) {
+        gen->sentinelNext[s] = gen->transitions[s * gen->numClasses + cls];
+        gen->transitions[s * gen->numClasses + cls] = 0;
+    }
+    return cls;
+}
+
+// Minimization can leave classes with identical columns; fold them together, except for
+// the sentinel class which must keep only the sentinel byte
+static void mergeByteClasses(LexerGen* gen, int sentinelClass) {
+    int numClasses = gen->numClasses;
+    int* merged = (int*)malloc(numClasses * sizeof(int));
+    int count = 0;
+
+    for (int cls = 0; cls < numClasses; cls++) {
+        merged[cls] = -1;
+        for (int other = 0; other < cls && cls != sentinelClass; other++) {
+            if (other == sentinelClass) {
+                continue;
+            }
+            int s;
+            for (s = 0; s < gen->numDfa; s++) {
+                if (gen->transitions[s * numClasses + cls] != gen->transitions[s * numClasses + other]) {
+                    break;
+                }
+            }
+            if (s == gen->numDfa) {
+                merged[cls] = merged[other];
+                break;
+            }
+        }
+        if (merged[cls] < 0) {
+            merged[cls] = count++;
+        }
+    }
+
+    int* transitions = (int*)malloc((size_t)gen->numDfa * count * sizeof(int));
+    for (int s = 0; s < gen->numDfa; s++) {
+        for (int cls = 0; cls < numClasses; cls++) {
+            transitions[s * count + merged[cls]] = gen->transitions[s * numClasses + cls];
+        }
+    }
+    for (int b = 0; b < 256; b++) {
+        gen->classOf[b] = merged[gen->classOf[b]];
+    }
+    free(gen->transitions);
+    gen->transitions = transitions;
+    gen->numClasses = count;
+    free(merged);
+}
+
+// Bytes on which a state moves to itself, as at most MAX_LOOP_RANGES ranges below 0x7F.
+// Returns 0 when the state has no such loop or it cannot be described that way; loops
+// over '\n' are left out so the runtime never has to count lines while scanning.
+static int loopRanges(LexerGen* gen, int state, int* lo, int* hi) {
+    int numRanges = 0;
+    int b = 0;
+
+    while (b < 256) {
+        if (gen->transitions[state * gen->numClasses + gen->classOf[b]] != state) {
+            b++;
+            continue;
+        }
+        int first = b;
+        while (b < 256 && gen->transitions[state * gen->numClasses + gen->classOf[b]] == state) {
+            b++;
+        }
+        if (b > 0x7F || (first <= '\n' && b > '\n') || numRanges == MAX_LOOP_RANGES) {
+            return 0;
+        }
+        lo[numRanges] = first;
+        hi[numRanges] = b - 1;
+        numRanges++;
+    }
+    return numRanges;
+}
+
+static void writeByte(FILE* out, int b) {
+    if (b >= 0x20 && b < 0x7F && b != '\'' && b != '\\') {
+        fprintf(out, "'%c'", b);
+    } else {
+        fprintf(out, "0x%02X", b);
+    }
+}
+
+static bool writeTables(LexerGen* gen, const char* specFile, const char* filename) {
+    FILE* out = fopen(filename, "w");
+    if (!out) {
+        printf("Error: Cannot open file %s\n", filename);
+        return false;
+    }
+
+    const char* stateType = gen->numDfa <= 256 ? "unsigned char" : "unsigned short";
+
+    fprintf(out, "// Generated by lexerGen from %s, do not edit.\n", specFile);
+    fprintf(out, "// Included by lexerFinal1.c, which defines the LEX_* actions and LexLoop.\n");
+    fprintf(out, "#ifndef LEXER_TABLES_H\n#define LEXER_TABLES_H\n\n");
+    fprintf(out, "#define LEX_NUM_STATES %d\n", gen->numDfa);
+    fprintf(out, "#define LEX_NUM_CLASSES %d\n", gen->numClasses);
+    fprintf(out, "#define LEX_DEAD 0\n");
+    fprintf(out, "#define LEX_START %d\n", gen->start);
+    fprintf(out, "#define LEX_SENTINEL 0x%02X\n\n", LEX_SENTINEL);
+
+    fprintf(out, "// Byte equivalence class of every input byte\n");
+    fprintf(out, "static const unsigned char lexClass[256] = {");
+    for (int b = 0; b < 256; b++) {
+        fprintf(out, "%s%3d,", (b % 16 == 0) ? "\n    " : " ", gen->classOf[b]);
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const %s lexTransitions[LEX_NUM_STATES][LEX_NUM_CLASSES] = {\n", stateType);
+    for (int s = 0; s < gen->numDfa; s++) {
+        fprintf(out, "    {");
+        for (int cls = 0; cls < gen->numClasses; cls++) {
+            fprintf(out, "%s%d", cls ? ", " : "", gen->transitions[s * gen->numClasses + cls]);
+        }
+        fprintf(out, "},\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Every state is dead on LEX_SENTINEL; this is where a real LEX_SENTINEL byte leads\n");
+    fprintf(out, "static const %s lexSentinelNext[LEX_NUM_STATES] = {", stateType);
+    for (int s = 0; s < gen->numDfa; s++) {
+        fprintf(out, "%s%d,", (s % 16 == 0) ? "\n    " : " ", gen->sentinelNext[s]);
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "// Token or LEX_* action of each accepting state, -1 for the others\n");
+    fprintf(out, "static const short lexAccept[LEX_NUM_STATES] = {\n");
+    for (int s = 0; s < gen->numDfa; s++) {
+        if (gen->accept[s] < 0) {
+            fprintf(out, "    -1,\n");
+        } else {
+            fprintf(out, "    %s,\n", gen->rules[gen->accept[s]].name);
+        }
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Byte ranges on which a state loops to itself, scanned without the table\n");
+    fprintf(out, "static const LexLoop lexLoop[LEX_NUM_STATES] = {\n");
+    for (int s = 0; s < gen->numDfa; s++) {
+        int lo[MAX_LOOP_RANGES], hi[MAX_LOOP_RANGES];
+        int numRanges = (s == 0) ? 0 : loopRanges(gen, s, lo, hi);
+        fprintf(out, "    {%d, {", numRanges);
+        for (int i = 0; i < MAX_LOOP_RANGES; i++) {
+            fprintf(out, "%s", i ? ", " : "");
+            writeByte(out, i < numRanges ? lo[i] : 1);
+        }
+        fprintf(out, "}, {");
+        for (int i = 0; i < MAX_LOOP_RANGES; i++) {
+            fprintf(out, "%s", i ? ", " : "");
+            writeByte(out, i < numRanges ? hi[i] : 0);
+        }
+        fprintf(out, "}},\n");
+    }
+    fprintf(out, "};\n\n#endif\n");
+
+    fclose(out);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage: %s <spec_file> <output_header>\n", argv[0]);
+        return 1;
+    }
+
+    LexerGen* gen = (LexerGen*)calloc(1, sizeof(LexerGen));
+    gen->nfa = (NfaState*)malloc(MAX_NFA_STATES * sizeof(NfaState));
+    gen->charsets = (ByteSet*)malloc(MAX_CHARSETS * sizeof(ByteSet));
+
+    if (!readSpec(gen, argv[1])) {
+        printf("Error: no rules read from %s\n", argv[1]);
+        return 1;
+    }
+    int nfaStart = buildNfa(gen);
+    if (nfaStart < 0) {
+        return 1;
+    }
+    // A set of its own keeps the sentinel byte out of every other class
+    setByte(&gen->charsets[newCharset(gen)], LEX_SENTINEL);
+    computeByteClasses(gen);
+    if (!buildDfa(gen, nfaStart)) {
+        return 1;
+    }
+    int unminimized = gen->numDfa;
+    minimizeDfa(gen);
+    mergeByteClasses(gen, splitSentinel(gen));
+
+    if (!writeTables(gen, argv[1], argv[2])) {
+        return 1;
+    }
+    printf("%d rules, %d NFA states, %d DFA states (%d before minimization), %d byte classes\n",
+           gen->numRules, gen->numNfa, gen->numDfa, unminimized, gen->numClasses);
+    return 0;
+}
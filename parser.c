@@ -551,15 +551,8 @@ void printFollowSets(Grammar* grammar, FirstAndFollow* fafl) {
 
 // Create parsing table based on First and Follow sets
 void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* grammar) {
-    // Initialize parse table
-    parseTable->table = (int**)malloc(grammar->numNonTerminals * sizeof(int*));
-    for (int i = 0; i < grammar->numNonTerminals; i++) {
-        parseTable->table[i] = (int*)calloc(grammar->numTerminals, sizeof(int));
-        // Initialize with -1 (error)
-        for (int j = 0; j < grammar->numTerminals; j++) {
-            parseTable->table[i][j] = -1;
-        }
-    }
+    // Initialize parse table (every entry starts as an error)
+    initParseTable(parseTable, grammar->numNonTerminals, grammar->numTerminals);
     
     // Find epsilon index
     int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
@@ -576,7 +569,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             rhsStart->id.terminal == epsilonIndex) {
             for (int j = 0; j < grammar->numTerminals; j++) {
                 if (fafl->follow[A][j]) {
-                    parseTable->table[A][j] = i;
+                    setParseTableEntry(parseTable, A, j, i);
                 }
             }
         } 
@@ -588,7 +581,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             
             for (int j = 0; j < grammar->numTerminals; j++) {
                 if (firstSet[j]) {
-                    parseTable->table[A][j] = i;
+                    setParseTableEntry(parseTable, A, j, i);
                 }
             }
             
@@ -596,7 +589,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             if (derivesEpsilon) {
                 for (int j = 0; j < grammar->numTerminals; j++) {
                     if (fafl->follow[A][j]) {
-                        parseTable->table[A][j] = i;
+                        setParseTableEntry(parseTable, A, j, i);
                     }
                 }
             }
@@ -630,10 +623,10 @@ void printParseTable(ParseTable* parseTable, Grammar* grammar) {
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == -1) {
                 printf("%-15s", "error");
             } else {
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
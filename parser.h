@@ -1,9 +1,26 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #define MAX_SYMBOL_LENGTH 50
 #define MAX_RULE_LENGTH 100
 
+// Special parse table entries
+#define PARSE_TABLE_ERROR -1
+#define PARSE_TABLE_SYNCH -2
+
+// Dense tables up to this size (in bytes) are kept as is, larger ones get compressed
+#ifndef PARSE_TABLE_DENSE_LIMIT
+#define PARSE_TABLE_DENSE_LIMIT 16384
+#endif
+
+// Each dense row is padded to a whole number of 64 byte cache lines
+#define PARSE_TABLE_ROW_ALIGN 32
+
 // Symbol Structure
 typedef union {
     int terminal;
@@ -54,10 +71,272 @@ typedef struct {
 } FirstAndFollow;
 
 // Parse Table Structure
+// Entries are rule numbers or PARSE_TABLE_ERROR / PARSE_TABLE_SYNCH. Small tables are one
+// contiguous row-major block; large ones are packed into a per-row default plus the
+// remaining entries placed with row displacement (next/check comb vectors).
 typedef struct {
-    int** table;
+    int numRows;
+    int numCols;
+    int stride;          // row length of the dense block, padded to PARSE_TABLE_ROW_ALIGN
+    int16_t* cells;      // dense block, NULL once compressed
+    bool compressed;
+    int16_t* rowDefault; // most frequent entry of each row
+    int* rowBase;        // offset of each row into next/check
+    int16_t* next;       // entries that differ from the row default
+    int16_t* check;      // row owning each slot of next, -1 if unused
+    int packedSize;
 } ParseTable;
 
+// Allocate a dense table with every entry set to PARSE_TABLE_ERROR
+static inline void initParseTable(ParseTable* parseTable, int numRows, int numCols) {
+    parseTable->numRows = numRows;
+    parseTable->numCols = numCols;
+    parseTable->stride = (numCols + PARSE_TABLE_ROW_ALIGN - 1) / PARSE_TABLE_ROW_ALIGN * PARSE_TABLE_ROW_ALIGN;
+    size_t bytes = (size_t)numRows * parseTable->stride * sizeof(int16_t);
+    if (bytes == 0) bytes = PARSE_TABLE_ROW_ALIGN * sizeof(int16_t);
+    parseTable->cells = (int16_t*)aligned_alloc(PARSE_TABLE_ROW_ALIGN * sizeof(int16_t), bytes);
+    memset(parseTable->cells, 0xFF, bytes); // all bits set is -1 (error)
+    parseTable->compressed = false;
+    parseTable->rowDefault = NULL;
+    parseTable->rowBase = NULL;
+    parseTable->next = NULL;
+    parseTable->check = NULL;
+    parseTable->packedSize = 0;
+}
+
+// Only valid before the table is compressed
+static inline void setParseTableEntry(ParseTable* parseTable, int row, int col, int value) {
+    parseTable->cells[row * parseTable->stride + col] = (int16_t)value;
+}
+
+static inline int getParseTableEntry(const ParseTable* parseTable, int row, int col) {
+    if (!parseTable->compressed) {
+        return parseTable->cells[row * parseTable->stride + col];
+    }
+    int slot = parseTable->rowBase[row] + col;
+    return (parseTable->check[slot] == row) ? parseTable->next[slot] : parseTable->rowDefault[row];
+}
+
+// LALR(1) action entries share the int16_t parse table storage:
+// shifts are the target state (>= 0), reductions are stored as -(rule + 3) and
+// reducing the augmented rule 0 accepts. Empty cells are PARSE_TABLE_ERROR.
+#define LALR_REDUCE(rule) (-(rule) - 3)
+#define LALR_ACCEPT LALR_REDUCE(0)
+#define LALR_IS_REDUCE(entry) ((entry) <= -3)
+#define LALR_RULE(entry) (-(entry) - 3)
+
+// LALR(1) Table Structure
+typedef struct {
+    Grammar* grammar;
+    int numStates;
+    ParseTable action;     // states x terminals
+    ParseTable gotoTable;  // states x non-terminals
+    int* ruleLength;       // RHS length of each rule, 0 for epsilon rules
+    int* ruleLhs;          // LHS non-terminal of each rule, -1 for the augmented rule 0
+    int shiftReduceConflicts;
+    int reduceReduceConflicts;
+} LALRTable;
+
+// Adaptive LL(*) prediction for parse table cells with more than one candidate rule.
+// Each conflicting cell gets a lookahead DFA that is built lazily: a state holds the
+// configurations (candidate rule + symbol stack) still alive after the tokens seen so far,
+// and once every surviving configuration agrees on a rule the state becomes a prediction.
+#ifndef LL_MAX_LOOKAHEAD
+#define LL_MAX_LOOKAHEAD 16
+#endif
+#define LL_CONFIG_STACK 24
+
+typedef struct {
+    int16_t rule;
+    int16_t depth;
+    int16_t stack[LL_CONFIG_STACK];  // top at stack[depth - 1]
+} LLConfig;
+
+typedef struct {
+    int prediction;      // rule to use, 0 while still undecided, -1 if no rule survives
+    int depth;           // tokens of lookahead consumed to reach this state
+    int* next;           // state reached on each terminal, -1 until simulated
+    LLConfig* configs;   // freed once the state predicts
+    int numConfigs;
+} LookaheadDFAState;
+
+typedef struct {
+    int nonTerminal;
+    int terminal;
+    int staticRule;      // rule the plain LL(1) table keeps for this cell
+    LookaheadDFAState* states;
+    int numStates;
+    int capacity;
+} LLDecision;
+
+typedef struct {
+    Grammar* grammar;
+    int numDecisions;
+    LLDecision* decisions;
+    int16_t* decisionOf;  // numNonTerminals x numTerminals, -1 for LL(1) cells
+    int* ruleLhs;
+    int* ruleLength;      // 0 for epsilon rules
+    int16_t** ruleRhs;    // encoded symbols, see llEncode* in parserTest.c
+    int** rulesOf;        // rule numbers of each non-terminal, -1 terminated
+    int** uses;           // (rule, position) pairs where each non-terminal occurs, -1 terminated
+    long predictions;
+    long simulations;     // DFA edges that had to be computed
+} AdaptivePredictor;
+
+// Binary parse tree file: a BinaryTreeHeader, the nodes in preorder (node 0 is the root),
+// then the lexeme pool of NUL terminated strings. Indices are node numbers, -1 for none.
+// Everything is in native byte order and laid out so the file can be mmap'ed and walked
+// as is; the fingerprint ties symbol ids to the grammar that produced them.
+#define BINARY_TREE_MAGIC "PTRB"
+#define BINARY_TREE_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t grammarFingerprint;
+    uint32_t numNodes;
+    uint32_t lexemeBytes;
+    uint32_t numTerminals;
+    uint32_t numNonTerminals;
+} BinaryTreeHeader;
+
+typedef struct {
+    int32_t symbol;      // terminal index if isTerminal, non-terminal index otherwise
+    int32_t isTerminal;
+    int32_t lineNumber;
+    int32_t ruleNumber;
+    int32_t parent;
+    int32_t firstChild;
+    int32_t nextSibling;
+    int32_t lexeme;      // offset into the lexeme pool, -1 for no lexeme
+} BinaryTreeNode;
+
+typedef struct {
+    void* base;
+    size_t size;
+    const BinaryTreeHeader* header;
+    const BinaryTreeNode* nodes;
+    const char* lexemes;
+} BinaryParseTree;
+
+// Define parse tree node structure
+typedef struct ParseTreeNode {
+    bool isTerminal;
+    int symbolIndex;
+    int lineNumber;
+    char lexeme[100];
+    int ruleNumber;      // rule that expanded this non-terminal, -1 for leaves
+    int collapsedRule;   // rule of the outermost node a compact tree folded into this one, -1 if none
+    struct ParseTreeNode* parent;
+    struct ParseTreeNode* firstChild;
+    struct ParseTreeNode* nextSibling;
+} ParseTreeNode;
+
+// Define parser stack element
+typedef struct StackElement {
+    bool isTerminal;
+    int symbolIndex;
+    ParseTreeNode* node;
+    struct StackElement* next;
+} StackElement;
+
+// Define stack structure
+typedef struct {
+    StackElement* top;
+} ParserStack;
+
+// Define token from lexer
+typedef struct {
+    char lexeme[100];
+    char token[50];
+    int lineNumber;
+    int terminalIndex;  // index into grammar->terminals, filled by resolveTokenTerminals
+} Token;
+
+// Leftmost derivation of one parse, 4 bytes per step: a rule number for each expansion,
+// TRACE_TOKEN | token index for each matched terminal, and TRACE_POP when error recovery
+// pops a symbol without matching or expanding it
+#define TRACE_TOKEN 0x80000000u
+#define TRACE_POP 0xFFFFFFFFu
+
+typedef struct {
+    uint32_t* steps;
+    int count;
+    int capacity;
+    bool error;
+} DerivationTrace;
+
+// Event-driven parsing: parseWithCallbacks builds no tree and reports the parse through
+// these callbacks instead. Any of them may be NULL. exitNonTerminal fires once every symbol
+// of the rule has been matched, so events nest like the tree would.
+typedef struct {
+    void (*enterNonTerminal)(void* userData, int rule, int line);
+    void (*token)(void* userData, int terminal, const char* lexeme, int line);
+    void (*exitNonTerminal)(void* userData, int rule);
+    void (*syntaxError)(void* userData, int line, const char* found, const char* message);
+    void* userData;
+} ParseCallbacks;
+
+// Posting-list index over a parse tree. Node ids are preorder (document order) positions;
+// the ids of every node with a given symbol are stored together, ascending, so a lookup
+// costs O(matches). Symbol keys are terminal t as t and non-terminal n as numTerminals + n.
+typedef struct {
+    ParseTreeNode* root;
+    bool ownsTree;       // free the tree along with the index
+    ParseTreeNode** nodes;
+    int numNodes;
+    int numTerminals;
+    int numSymbols;
+    int* offsets;        // postings of symbol k are postings[offsets[k] .. offsets[k + 1])
+    int* postings;
+} ParseTreeIndex;
+
+// Resumable LL(1) parse for tokens that arrive a few at a time. LL(1) decides everything
+// from the current token, so each fed token is processed completely and nothing is
+// buffered; the state between calls is the parser stack and the partial tree.
+typedef struct {
+    Grammar* grammar;
+    ParseTable* parseTable;
+    ParserStack* stack;
+    ParseTreeNode* root;
+    int dollarIndex;
+    int epsilonIndex;
+    int lastLine;        // line of the last token fed, used for the end marker
+    long tokensFed;
+    bool error;
+} PushParser;
+
+// Parse tree kept up to date across edits. tokens is the edited input, ending with
+// TK_DOLLAR; tokens dropped by error recovery and unknown tokens have no leaf, so every
+// reparse reads its tokens from there. leaves lists the leaf of every matched token in
+// input order, so the tokens of a line range are found by binary search on line numbers.
+typedef struct {
+    Grammar* grammar;
+    ParseTable* parseTable;
+    Token* tokens;
+    int numTokens;
+    int tokenCapacity;
+    ParseTreeNode* root;
+    ParseTreeNode** leaves;
+    int numLeaves;
+    int capacity;
+    bool error;
+    int reparsedTokens;  // tokens the last edit had to parse again
+    int stmtIndex;       // non-terminals whose subtrees get parsed again on their own
+    int functionIndex;
+    int mainFunctionIndex;
+} IncrementalParse;
+
+// Token source for the streaming parser: one token of lookahead read straight from the
+// lexer output file, ending with a TK_DOLLAR token at end of file
+typedef struct {
+    FILE* file;
+    Grammar* grammar;
+    Token current;
+    bool atEnd;
+    long tokensRead;
+} TokenStream;
+
 // Function prototypes
 Grammar* readGrammarFromFile(const char* filename);
 void printGrammar(Grammar* grammar);
@@ -65,11 +344,71 @@ FirstAndFollow* computeFirstAndFollowSets(Grammar* grammar);
 void printFirstSets(Grammar* grammar, FirstAndFollow* fafl);
 void printFollowSets(Grammar* grammar, FirstAndFollow* fafl);
 void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* grammar);
+void compressParseTable(ParseTable* parseTable);
+size_t parseTableMemory(ParseTable* parseTable);
+void freeParseTable(ParseTable* parseTable);
 void printParseTable(ParseTable* parseTable, Grammar* grammar);
 void writeParseTableToCsv(ParseTable* parseTable, Grammar* grammar, const char* filename);
 void writeParseTableToHtml(ParseTable* parseTable, Grammar* grammar, const char* filename);
+void generateRecursiveDescentParser(Grammar* grammar, ParseTable* parseTable, const char* filename);
+LALRTable* createLALRTable(Grammar* grammar);
+AdaptivePredictor* createAdaptivePredictor(Grammar* grammar, FirstAndFollow* fafl);
+void freeAdaptivePredictor(AdaptivePredictor* predictor);
 void parseSourceCode(Grammar* grammar, ParseTable* parseTable, const char* tokenFile, const char* parseTreeFile);
 int findTerminalIndex(Grammar* grammar, const char* terminal);
 int findNonTerminalIndex(Grammar* grammar, const char* nonTerminal);
+uint64_t grammarFingerprint(Grammar* grammar);
+BinaryParseTree* mapBinaryParseTree(const char* filename, Grammar* grammar);
+void unmapBinaryParseTree(BinaryParseTree* tree);
+ParserStack* createStack();
+void push(ParserStack* stack, bool isTerminal, int symbolIndex, ParseTreeNode* node);
+StackElement* pop(ParserStack* stack);
+ParseTreeNode* createNode(bool isTerminal, int symbolIndex, int lineNumber, const char* lexeme);
+void addChild(ParseTreeNode* parent, ParseTreeNode* child);
+void compactParseTreeNode(ParseTreeNode* node);
+void printStackContents(ParserStack* stack, Grammar* grammar);
+void printParseTree(ParseTreeNode* node, Grammar* grammar, int depth);
+void inorderTraversal(ParseTreeNode* node, Grammar* grammar, FILE* outFile);
+void freeParseTree(ParseTreeNode* node);
+bool parseTreesEqual(ParseTreeNode* a, ParseTreeNode* b);
+ParseTreeIndex* buildParseTreeIndex(ParseTreeNode* root, Grammar* grammar);
+void freeParseTreeIndex(ParseTreeIndex* index);
+int queryTerminalNodes(const ParseTreeIndex* index, int terminal, const int** ids);
+int queryNonTerminalNodes(const ParseTreeIndex* index, int nonTerminal, const int** ids);
+int querySymbolNodes(const ParseTreeIndex* index, Grammar* grammar, const char* symbol, const int** ids);
+Token* readTokensFromFile(const char* filename, int* numTokens);
+void resolveTokenTerminals(Grammar* grammar, Token* tokens, int numTokens);
+int adaptivePredict(AdaptivePredictor* predictor, int decisionIndex, Token* tokens, int pos, int numTokens);
+ParseTreeNode* runPredictiveParser(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                                   Token* tokens, int numTokens, bool compactTree, FILE* logFile, bool* hadError);
+ParseTreeNode* runPredictiveParserFrom(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                                       int startIndex, Token* tokens, int numTokens, bool compactTree,
+                                       FILE* logFile, bool* hadError);
+void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, const char* parseTreeFile,
+                 ParseTreeIndex** index);
+PushParser* createPushParser(Grammar* grammar, ParseTable* parseTable);
+bool parserFeed(PushParser* state, Token* tokens, int n);
+ParseTreeNode* parserFinish(PushParser* state, bool* hadError);
+IncrementalParse* createIncrementalParse(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens);
+bool reparseEditedLines(IncrementalParse* inc, int firstLine, int lastLine, Token* newTokens, int numNew,
+                        int newLastLine);
+void freeIncrementalParse(IncrementalParse* inc);
+void recordDerivation(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                      Token* tokens, int numTokens, DerivationTrace* trace);
+ParseTreeNode* materializeParseTree(Grammar* grammar, DerivationTrace* trace, Token* tokens, bool compactTree);
+void freeDerivationTrace(DerivationTrace* trace);
+bool parseWithCallbacks(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                        Token* tokens, int numTokens, ParseCallbacks* callbacks);
+bool streamParseTokens(Grammar* grammar, ParseTable* parseTable, const char* tokenFile,
+                       const char* parseTreeFile, int* peakStackDepth);
+ParseTreeNode* parseFunctionsInParallel(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                                        int numThreads, bool* hadError);
+bool writeBinaryParseTree(ParseTreeNode* root, Grammar* grammar, const char* filename);
+void inorderTraversalBinary(const BinaryParseTree* tree, Grammar* grammar, FILE* outFile);
+void writeParseTreeJson(ParseTreeNode* root, Grammar* grammar, bool ndjson, FILE* outFile);
+bool parseToJson(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                 bool ndjson, FILE* outFile);
+ParseTreeNode* runLALRParser(LALRTable* lalr, Token* tokens, int numTokens, FILE* logFile, bool* hadError);
+int countParseTreeNodes(ParseTreeNode* node, int depth, int* maxDepth);
 
 #endif // PARSER_H
\ No newline at end of file
@@ -552,15 +552,8 @@ void printFollowSets(Grammar* grammar, FirstAndFollow* fafl) {
 // Create parsing table based on First and Follow sets
 // with error recovery using synchronizing tokens
 void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* grammar) {
-    // Initialize parse table
-    parseTable->table = (int**)malloc(grammar->numNonTerminals * sizeof(int*));
-    for (int i = 0; i < grammar->numNonTerminals; i++) {
-        parseTable->table[i] = (int*)calloc(grammar->numTerminals, sizeof(int));
-        // Initialize with -1 (error)
-        for (int j = 0; j < grammar->numTerminals; j++) {
-            parseTable->table[i][j] = -1;
-        }
-    }
+    // Initialize parse table (every entry starts as an error)
+    initParseTable(parseTable, grammar->numNonTerminals, grammar->numTerminals);
     
     // Find epsilon index
     int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
@@ -577,7 +570,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             rhsStart->id.terminal == epsilonIndex) {
             for (int j = 0; j < grammar->numTerminals; j++) {
                 if (fafl->follow[A][j]) {
-                    parseTable->table[A][j] = i;
+                    setParseTableEntry(parseTable, A, j, i);
                 }
             }
         } 
@@ -589,7 +582,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             
             for (int j = 0; j < grammar->numTerminals; j++) {
                 if (firstSet[j]) {
-                    parseTable->table[A][j] = i;
+                    setParseTableEntry(parseTable, A, j, i);
                 }
             }
             
@@ -597,7 +590,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             if (derivesEpsilon) {
                 for (int j = 0; j < grammar->numTerminals; j++) {
                     if (fafl->follow[A][j]) {
-                        parseTable->table[A][j] = i;
+                        setParseTableEntry(parseTable, A, j, i);
                     }
                 }
             }
@@ -613,9 +606,9 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             if (j == epsilonIndex) continue;
             
             // Only mark as synch if it's currently an error (-1) and is in the FOLLOW set
-            if (parseTable->table[i][j] == -1 && fafl->follow[i][j]) {
+            if (getParseTableEntry(parseTable, i, j) == -1 && fafl->follow[i][j]) {
                 // Use a special value to mark synch entries: -2
-                parseTable->table[i][j] = -2;
+                setParseTableEntry(parseTable, i, j, -2);
             }
         }
     }
@@ -647,12 +640,12 @@ void printParseTable(ParseTable* parseTable, Grammar* grammar) {
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == -1) {
                 printf("%-15s", "error");
-            } else if (parseTable->table[i][j] == -2) {
+            } else if (getParseTableEntry(parseTable, i, j) == -2) {
                 printf("%-15s", "synch");
             } else {
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -708,11 +701,11 @@ void writeParseTableToFile(ParseTable* parseTable, Grammar* grammar, const char*
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == -1) {
                 fprintf(file, "%-15s", "error");
             } else {
                 char buffer[100] = {0};
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -768,12 +761,12 @@ void writeParseTableToCsv(ParseTable* parseTable, Grammar* grammar, const char*
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == -1) {
                 fprintf(file, "\"error\",");
-            } else if (parseTable->table[i][j] == -2) {
+            } else if (getParseTableEntry(parseTable, i, j) == -2) {
                 fprintf(file, "\"synch\",");
             } else {
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -862,14 +855,14 @@ void writeParseTableToHtml(ParseTable* parseTable, Grammar* grammar, const char*
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == -1) {
                 fprintf(file, "      <td class=\"error\">error</td>\n");
-            } else if (parseTable->table[i][j] == -2) {
+            } else if (getParseTableEntry(parseTable, i, j) == -2) {
                 fprintf(file, "      <td class=\"synch\">synch</td>\n");
             } else {
                 fprintf(file, "      <td class=\"rule\">");
                 
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -4,10 +4,15 @@
 #include <stdbool.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "parser.h"
 
 #define EPSILON_TOKEN "TK_EPS"
 #define DOLLAR_TOKEN "TK_DOLLAR"
+#define LA_WORDS(n) (((n) + 63) / 64)
 
 // Helper functions for symbol and rule management
 Symbol* createSymbol(bool isTerminal, int id) {
@@ -549,21 +554,33 @@ void printFollowSets(Grammar* grammar, FirstAndFollow* fafl) {
     }
 }
 
+// Enter rule into M[A, b]. A different rule already in the cell is an LL(1) conflict:
+// it is reported and the later rule wins (createAdaptivePredictor can resolve these cells).
+static void addParseTableRule(ParseTable* parseTable, Grammar* grammar, int A, int b, int rule, int* conflicts) {
+    int existing = getParseTableEntry(parseTable, A, b);
+    if (existing > 0 && existing != rule) {
+        printf("Warning: LL(1) conflict in M[%s, %s]: rule %d replaces rule %d\n",
+               grammar->nonTerminals[A], grammar->terminals[b], rule, existing);
+        (*conflicts)++;
+    }
+    setParseTableEntry(parseTable, A, b, rule);
+}
+
 // Create parsing table based on First and Follow sets
 // with error recovery using synchronizing tokens
 void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* grammar) {
-    // Initialize parse table
-    parseTable->table = (int**)malloc(grammar->numNonTerminals * sizeof(int*));
-    for (int i = 0; i < grammar->numNonTerminals; i++) {
-        parseTable->table[i] = (int*)calloc(grammar->numTerminals, sizeof(int));
-        // Initialize with -1 (error)
-        for (int j = 0; j < grammar->numTerminals; j++) {
-            parseTable->table[i][j] = -1;
-        }
+    // Rule numbers are stored as int16_t
+    if (grammar->numRules > INT16_MAX) {
+        printf("Error: grammar has %d rules, parse table supports at most %d\n", grammar->numRules, INT16_MAX);
+        exit(1);
     }
+
+    // Initialize parse table (every entry starts as an error)
+    initParseTable(parseTable, grammar->numNonTerminals, grammar->numTerminals);
     
     // Find epsilon index
     int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    int conflicts = 0;
     
     // Build the table
     for (int i = 1; i <= grammar->numRules; i++) {
@@ -577,7 +594,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             rhsStart->id.terminal == epsilonIndex) {
             for (int j = 0; j < grammar->numTerminals; j++) {
                 if (fafl->follow[A][j]) {
-                    parseTable->table[A][j] = i;
+                    addParseTableRule(parseTable, grammar, A, j, i, &conflicts);
                 }
             }
         } 
@@ -589,7 +606,7 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             
             for (int j = 0; j < grammar->numTerminals; j++) {
                 if (firstSet[j]) {
-                    parseTable->table[A][j] = i;
+                    addParseTableRule(parseTable, grammar, A, j, i, &conflicts);
                 }
             }
             
@@ -597,13 +614,17 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             if (derivesEpsilon) {
                 for (int j = 0; j < grammar->numTerminals; j++) {
                     if (fafl->follow[A][j]) {
-                        parseTable->table[A][j] = i;
+                        addParseTableRule(parseTable, grammar, A, j, i, &conflicts);
                     }
                 }
             }
         }
     }
     
+    if (conflicts > 0) {
+        printf("Grammar is not LL(1): %d conflicting parse table entries\n", conflicts);
+    }
+    
     // Add synchronizing tokens for error recovery
     // For each non-terminal, a "synch" entry is added for any terminal in its FOLLOW set
     // where there is currently an error entry
@@ -613,12 +634,450 @@ void createParseTable(FirstAndFollow* fafl, ParseTable* parseTable, Grammar* gra
             if (j == epsilonIndex) continue;
             
             // Only mark as synch if it's currently an error (-1) and is in the FOLLOW set
-            if (parseTable->table[i][j] == -1 && fafl->follow[i][j]) {
+            if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_ERROR && fafl->follow[i][j]) {
                 // Use a special value to mark synch entries: -2
-                parseTable->table[i][j] = -2;
+                setParseTableEntry(parseTable, i, j, PARSE_TABLE_SYNCH);
+            }
+        }
+    }
+
+    // Big grammars get packed so the table still fits in cache while parsing
+    if (parseTableMemory(parseTable) > PARSE_TABLE_DENSE_LIMIT) {
+        compressParseTable(parseTable);
+    }
+}
+
+// Pack the dense table into per-row defaults plus exceptions placed by row displacement.
+// Lookups stay O(1): one check of check[base + col], falling back to the row default.
+void compressParseTable(ParseTable* parseTable) {
+    if (parseTable->compressed) return;
+
+    int rows = parseTable->numRows;
+    int cols = parseTable->numCols;
+
+    // Find the most frequent entry of each row (any int16_t value, offset by 32768)
+    parseTable->rowDefault = (int16_t*)malloc(rows * sizeof(int16_t));
+    int* exceptionCount = (int*)calloc(rows, sizeof(int));
+    int* counts = (int*)malloc(65536 * sizeof(int));
+
+    for (int i = 0; i < rows; i++) {
+        int16_t* row = parseTable->cells + i * parseTable->stride;
+        int best = row[0];
+        for (int j = 0; j < cols; j++) counts[row[j] + 32768] = 0;
+        for (int j = 0; j < cols; j++) {
+            if (++counts[row[j] + 32768] > counts[best + 32768]) best = row[j];
+        }
+        parseTable->rowDefault[i] = (int16_t)best;
+        for (int j = 0; j < cols; j++) {
+            if (row[j] != best) exceptionCount[i]++;
+        }
+    }
+    free(counts);
+
+    // Place the densest rows first, each at the lowest offset where its exceptions fit
+    int* order = (int*)malloc(rows * sizeof(int));
+    for (int i = 0; i < rows; i++) order[i] = i;
+    for (int i = 1; i < rows; i++) {
+        int current = order[i];
+        int k = i - 1;
+        while (k >= 0 && exceptionCount[order[k]] < exceptionCount[current]) {
+            order[k + 1] = order[k];
+            k--;
+        }
+        order[k + 1] = current;
+    }
+
+    int capacity = rows * cols + cols;
+    parseTable->rowBase = (int*)calloc(rows, sizeof(int));
+    parseTable->next = (int16_t*)malloc(capacity * sizeof(int16_t));
+    parseTable->check = (int16_t*)malloc(capacity * sizeof(int16_t));
+    memset(parseTable->check, 0xFF, capacity * sizeof(int16_t));
+    int used = 0;
+
+    for (int k = 0; k < rows && exceptionCount[order[k]] > 0; k++) {
+        int i = order[k];
+        int16_t* row = parseTable->cells + i * parseTable->stride;
+        int base = 0;
+        bool fits = false;
+
+        while (!fits) {
+            fits = true;
+            for (int j = 0; j < cols; j++) {
+                if (row[j] != parseTable->rowDefault[i] && parseTable->check[base + j] != -1) {
+                    fits = false;
+                    base++;
+                    break;
+                }
+            }
+        }
+
+        parseTable->rowBase[i] = base;
+        for (int j = 0; j < cols; j++) {
+            if (row[j] != parseTable->rowDefault[i]) {
+                parseTable->next[base + j] = row[j];
+                parseTable->check[base + j] = (int16_t)i;
+                if (base + j + 1 > used) used = base + j + 1;
+            }
+        }
+    }
+
+    // Every row reads at most cols slots past its base, so keep that much tail
+    int maxBase = 0;
+    for (int i = 0; i < rows; i++) {
+        if (parseTable->rowBase[i] > maxBase) maxBase = parseTable->rowBase[i];
+    }
+    parseTable->packedSize = (maxBase + cols > used) ? maxBase + cols : used;
+    parseTable->next = (int16_t*)realloc(parseTable->next, parseTable->packedSize * sizeof(int16_t));
+    parseTable->check = (int16_t*)realloc(parseTable->check, parseTable->packedSize * sizeof(int16_t));
+
+    free(order);
+    free(exceptionCount);
+    free(parseTable->cells);
+    parseTable->cells = NULL;
+    parseTable->compressed = true;
+}
+
+// Bytes touched by lookups into the parse table
+size_t parseTableMemory(ParseTable* parseTable) {
+    if (!parseTable->compressed) {
+        return (size_t)parseTable->numRows * parseTable->stride * sizeof(int16_t);
+    }
+    return (size_t)parseTable->numRows * (sizeof(int16_t) + sizeof(int)) +
+           (size_t)parseTable->packedSize * 2 * sizeof(int16_t);
+}
+
+void freeParseTable(ParseTable* parseTable) {
+    free(parseTable->cells);
+    free(parseTable->rowDefault);
+    free(parseTable->rowBase);
+    free(parseTable->next);
+    free(parseTable->check);
+    parseTable->cells = NULL;
+    parseTable->rowDefault = NULL;
+    parseTable->rowBase = NULL;
+    parseTable->next = NULL;
+    parseTable->check = NULL;
+}
+
+// Adaptive LL(*) prediction
+// Symbols on a configuration stack are encoded as small integers:
+// terminals keep their index, non-terminal n is numTerminals + n, and the marker for
+// "whatever may follow n" is numTerminals + numNonTerminals + n. The marker only ever
+// sits at the bottom of a stack, so lookahead never depends on the parser's real stack
+// and every lookahead DFA edge can be cached.
+typedef struct {
+    LLConfig* items;
+    int count;
+    int capacity;
+} LLConfigSet;
+
+static bool llConfigEqual(const LLConfig* a, const LLConfig* b) {
+    return a->rule == b->rule && a->depth == b->depth &&
+           memcmp(a->stack, b->stack, a->depth * sizeof(int16_t)) == 0;
+}
+
+// Add a configuration unless the set already has it
+static bool llSetAdd(LLConfigSet* set, const LLConfig* config) {
+    for (int i = 0; i < set->count; i++) {
+        if (llConfigEqual(&set->items[i], config)) return false;
+    }
+    if (set->count == set->capacity) {
+        set->capacity = set->capacity ? set->capacity * 2 : 8;
+        set->items = (LLConfig*)realloc(set->items, set->capacity * sizeof(LLConfig));
+    }
+    set->items[set->count++] = *config;
+    return true;
+}
+
+// Expand the configuration until a terminal (or nothing at all) is on top of its stack
+static void llClosure(AdaptivePredictor* predictor, const LLConfig* config, LLConfigSet* out, LLConfigSet* seen) {
+    if (!llSetAdd(seen, config)) return;
+    
+    Grammar* grammar = predictor->grammar;
+    int T = grammar->numTerminals;
+    int N = grammar->numNonTerminals;
+    
+    // Empty stack: the whole input has been accounted for, including $
+    if (config->depth == 0) {
+        llSetAdd(out, config);
+        return;
+    }
+    
+    int top = config->stack[config->depth - 1];
+    LLConfig next;
+    
+    if (top < T) {
+        llSetAdd(out, config);
+    } else if (top < T + N) {
+        // Non-terminal: replace it by the right-hand side of each of its rules
+        for (int* r = predictor->rulesOf[top - T]; *r != -1; r++) {
+            int length = predictor->ruleLength[*r];
+            // Left recursion keeps growing the stack, give up on that path
+            if (config->depth - 1 + length > LL_CONFIG_STACK) continue;
+            
+            next = *config;
+            next.depth--;
+            for (int k = length - 1; k >= 0; k--) {
+                next.stack[next.depth++] = predictor->ruleRhs[*r][k];
+            }
+            llClosure(predictor, &next, out, seen);
+        }
+    } else {
+        // Follow marker: continue with the rest of every rule that uses the non-terminal
+        int X = top - T - N;
+        for (int* use = predictor->uses[X]; *use != -1; use += 2) {
+            int r = use[0];
+            int position = use[1];
+            int length = predictor->ruleLength[r];
+            if (length - position > LL_CONFIG_STACK) continue;
+            
+            next = *config;
+            next.depth = 0;
+            next.stack[next.depth++] = T + N + predictor->ruleLhs[r];
+            for (int k = length - 1; k > position; k--) {
+                next.stack[next.depth++] = predictor->ruleRhs[r][k];
+            }
+            llClosure(predictor, &next, out, seen);
+        }
+        
+        if (X == findNonTerminalIndex(grammar, grammar->startSymbol)) {
+            next = *config;
+            next.depth = 0;
+            next.stack[next.depth++] = findTerminalIndex(grammar, DOLLAR_TOKEN);
+            llClosure(predictor, &next, out, seen);
+        }
+    }
+}
+
+// Configurations of from that match terminal t, with t consumed
+static void llMove(AdaptivePredictor* predictor, LLConfigSet* from, int t, LLConfigSet* out) {
+    LLConfigSet seen = {NULL, 0, 0};
+    
+    for (int i = 0; i < from->count; i++) {
+        LLConfig* config = &from->items[i];
+        if (config->depth > 0 && config->stack[config->depth - 1] == t) {
+            LLConfig next = *config;
+            next.depth--;
+            llClosure(predictor, &next, out, &seen);
+        }
+    }
+    
+    free(seen.items);
+}
+
+// When the lookahead runs out without a unique answer the first alternative wins
+static int llLowestRule(LLConfig* configs, int numConfigs) {
+    int lowest = -1;
+    for (int i = 0; i < numConfigs; i++) {
+        if (lowest == -1 || configs[i].rule < lowest) lowest = configs[i].rule;
+    }
+    return lowest;
+}
+
+// Append a DFA state for the configuration set, taking ownership of its items
+static int llAddState(AdaptivePredictor* predictor, LLDecision* decision, LLConfigSet* configs, int depth) {
+    if (decision->numStates == decision->capacity) {
+        decision->capacity = decision->capacity ? decision->capacity * 2 : 4;
+        decision->states = (LookaheadDFAState*)realloc(decision->states,
+                                                       decision->capacity * sizeof(LookaheadDFAState));
+    }
+    
+    LookaheadDFAState* state = &decision->states[decision->numStates];
+    state->depth = depth;
+    state->next = NULL;
+    state->configs = NULL;
+    state->numConfigs = 0;
+    
+    if (configs->count == 0) {
+        state->prediction = -1;
+    } else {
+        state->prediction = configs->items[0].rule;
+        for (int i = 1; i < configs->count; i++) {
+            if (configs->items[i].rule != state->prediction) {
+                state->prediction = 0;
+                break;
+            }
+        }
+    }
+    
+    if (state->prediction == 0 && depth >= LL_MAX_LOOKAHEAD) {
+        state->prediction = llLowestRule(configs->items, configs->count);
+    }
+    
+    if (state->prediction == 0) {
+        int numTerminals = predictor->grammar->numTerminals;
+        state->next = (int*)malloc(numTerminals * sizeof(int));
+        for (int t = 0; t < numTerminals; t++) {
+            state->next[t] = -1;
+        }
+        state->configs = configs->items;
+        state->numConfigs = configs->count;
+    } else {
+        free(configs->items);
+    }
+    configs->items = NULL;
+    configs->count = configs->capacity = 0;
+    
+    return decision->numStates++;
+}
+
+// Find every parse table cell with more than one candidate rule and give it a lookahead DFA.
+// Only the start state of each DFA is built here, the rest is simulated on first use.
+AdaptivePredictor* createAdaptivePredictor(Grammar* grammar, FirstAndFollow* fafl) {
+    AdaptivePredictor* predictor = (AdaptivePredictor*)calloc(1, sizeof(AdaptivePredictor));
+    predictor->grammar = grammar;
+    
+    int T = grammar->numTerminals;
+    int N = grammar->numNonTerminals;
+    int numRules = grammar->numRules;
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    
+    // Encode every right-hand side once
+    predictor->ruleLhs = (int*)malloc((numRules + 1) * sizeof(int));
+    predictor->ruleLength = (int*)calloc(numRules + 1, sizeof(int));
+    predictor->ruleRhs = (int16_t**)calloc(numRules + 1, sizeof(int16_t*));
+    int* ruleCount = (int*)calloc(N, sizeof(int));
+    int* useCount = (int*)calloc(N, sizeof(int));
+    
+    for (int i = 1; i <= numRules; i++) {
+        Symbol* lhs = grammar->rules[i]->symbols->head;
+        predictor->ruleLhs[i] = lhs->id.nonTerminal;
+        ruleCount[lhs->id.nonTerminal]++;
+        predictor->ruleRhs[i] = (int16_t*)malloc(grammar->rules[i]->symbols->length * sizeof(int16_t));
+        
+        for (Symbol* sym = lhs->next; sym != NULL; sym = sym->next) {
+            if (sym->isTerminal && sym->id.terminal == epsilonIndex) continue;
+            if (!sym->isTerminal) useCount[sym->id.nonTerminal]++;
+            predictor->ruleRhs[i][predictor->ruleLength[i]++] =
+                sym->isTerminal ? sym->id.terminal : T + sym->id.nonTerminal;
+        }
+    }
+    
+    predictor->rulesOf = (int**)malloc(N * sizeof(int*));
+    predictor->uses = (int**)malloc(N * sizeof(int*));
+    for (int n = 0; n < N; n++) {
+        predictor->rulesOf[n] = (int*)malloc((ruleCount[n] + 1) * sizeof(int));
+        predictor->uses[n] = (int*)malloc((2 * useCount[n] + 1) * sizeof(int));
+        ruleCount[n] = useCount[n] = 0;
+    }
+    for (int i = 1; i <= numRules; i++) {
+        int A = predictor->ruleLhs[i];
+        predictor->rulesOf[A][ruleCount[A]++] = i;
+        for (int k = 0; k < predictor->ruleLength[i]; k++) {
+            int sym = predictor->ruleRhs[i][k];
+            if (sym < T) continue;
+            predictor->uses[sym - T][useCount[sym - T]++] = i;
+            predictor->uses[sym - T][useCount[sym - T]++] = k;
+        }
+    }
+    for (int n = 0; n < N; n++) {
+        predictor->rulesOf[n][ruleCount[n]] = -1;
+        predictor->uses[n][useCount[n]] = -1;
+    }
+    free(ruleCount);
+    free(useCount);
+    
+    // Collect the candidate rules of every cell, exactly as createParseTable fills it
+    bool* candidate = (bool*)calloc((size_t)N * T * (numRules + 1), sizeof(bool));
+    int* numCandidates = (int*)calloc(N * T, sizeof(int));
+    int* lastCandidate = (int*)calloc(N * T, sizeof(int));
+    
+    for (int i = 1; i <= numRules; i++) {
+        int A = predictor->ruleLhs[i];
+        bool firstSet[T];
+        bool derivesEpsilon = true;
+        
+        memset(firstSet, 0, sizeof(firstSet));
+        if (predictor->ruleLength[i] > 0) {
+            getFirstOfSequence(grammar, fafl, grammar->rules[i]->symbols->head->next, firstSet, &derivesEpsilon);
+        }
+        
+        for (int j = 0; j < T; j++) {
+            if (firstSet[j] || (derivesEpsilon && fafl->follow[A][j])) {
+                int cell = A * T + j;
+                if (!candidate[(size_t)cell * (numRules + 1) + i]) {
+                    candidate[(size_t)cell * (numRules + 1) + i] = true;
+                    numCandidates[cell]++;
+                    lastCandidate[cell] = i;
+                }
+            }
+        }
+    }
+    
+    // Give each conflicting cell a decision and the DFA state reached after its own token
+    predictor->decisionOf = (int16_t*)malloc(N * T * sizeof(int16_t));
+    for (int cell = 0; cell < N * T; cell++) {
+        predictor->decisionOf[cell] = -1;
+        if (numCandidates[cell] < 2) continue;
+        
+        int A = cell / T;
+        int j = cell % T;
+        predictor->decisions = (LLDecision*)realloc(predictor->decisions,
+                                                    (predictor->numDecisions + 1) * sizeof(LLDecision));
+        LLDecision* decision = &predictor->decisions[predictor->numDecisions];
+        decision->nonTerminal = A;
+        decision->terminal = j;
+        decision->staticRule = lastCandidate[cell];
+        decision->states = NULL;
+        decision->numStates = decision->capacity = 0;
+        
+        LLConfigSet initial = {NULL, 0, 0};
+        LLConfigSet seen = {NULL, 0, 0};
+        LLConfigSet start = {NULL, 0, 0};
+        
+        for (int i = 1; i <= numRules; i++) {
+            if (!candidate[(size_t)cell * (numRules + 1) + i]) continue;
+            if (predictor->ruleLength[i] + 1 > LL_CONFIG_STACK) continue;
+            
+            LLConfig config;
+            config.rule = i;
+            config.depth = 0;
+            config.stack[config.depth++] = T + N + A;
+            for (int k = predictor->ruleLength[i] - 1; k >= 0; k--) {
+                config.stack[config.depth++] = predictor->ruleRhs[i][k];
             }
+            llClosure(predictor, &config, &initial, &seen);
+        }
+        llMove(predictor, &initial, j, &start);
+        llAddState(predictor, decision, &start, 1);
+        free(initial.items);
+        free(seen.items);
+        
+        predictor->decisionOf[cell] = predictor->numDecisions++;
+    }
+    
+    free(candidate);
+    free(numCandidates);
+    free(lastCandidate);
+    
+    return predictor;
+}
+
+void freeAdaptivePredictor(AdaptivePredictor* predictor) {
+    if (predictor == NULL) return;
+    
+    for (int d = 0; d < predictor->numDecisions; d++) {
+        for (int s = 0; s < predictor->decisions[d].numStates; s++) {
+            free(predictor->decisions[d].states[s].next);
+            free(predictor->decisions[d].states[s].configs);
         }
+        free(predictor->decisions[d].states);
     }
+    for (int n = 0; n < predictor->grammar->numNonTerminals; n++) {
+        free(predictor->rulesOf[n]);
+        free(predictor->uses[n]);
+    }
+    for (int i = 1; i <= predictor->grammar->numRules; i++) {
+        free(predictor->ruleRhs[i]);
+    }
+    free(predictor->decisions);
+    free(predictor->decisionOf);
+    free(predictor->ruleLhs);
+    free(predictor->ruleLength);
+    free(predictor->ruleRhs);
+    free(predictor->rulesOf);
+    free(predictor->uses);
+    free(predictor);
 }
 
 // Function to print the parse table
@@ -647,12 +1106,12 @@ void printParseTable(ParseTable* parseTable, Grammar* grammar) {
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_ERROR) {
                 printf("%-15s", "error");
-            } else if (parseTable->table[i][j] == -2) {
+            } else if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_SYNCH) {
                 printf("%-15s", "synch");
             } else {
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -708,11 +1167,11 @@ void writeParseTableToFile(ParseTable* parseTable, Grammar* grammar, const char*
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_ERROR) {
                 fprintf(file, "%-15s", "error");
             } else {
                 char buffer[100] = {0};
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -768,12 +1227,12 @@ void writeParseTableToCsv(ParseTable* parseTable, Grammar* grammar, const char*
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_ERROR) {
                 fprintf(file, "\"error\",");
-            } else if (parseTable->table[i][j] == -2) {
+            } else if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_SYNCH) {
                 fprintf(file, "\"synch\",");
             } else {
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -862,14 +1321,14 @@ void writeParseTableToHtml(ParseTable* parseTable, Grammar* grammar, const char*
         for (int j = 0; j < grammar->numTerminals; j++) {
             if (strcmp(grammar->terminals[j], EPSILON_TOKEN) == 0) continue;
             
-            if (parseTable->table[i][j] == -1) {
+            if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_ERROR) {
                 fprintf(file, "      <td class=\"error\">error</td>\n");
-            } else if (parseTable->table[i][j] == -2) {
+            } else if (getParseTableEntry(parseTable, i, j) == PARSE_TABLE_SYNCH) {
                 fprintf(file, "      <td class=\"synch\">synch</td>\n");
             } else {
                 fprintf(file, "      <td class=\"rule\">");
                 
-                Rule* rule = grammar->rules[parseTable->table[i][j]];
+                Rule* rule = grammar->rules[getParseTableEntry(parseTable, i, j)];
                 Symbol* lhs = rule->symbols->head;
                 Symbol* rhs = lhs->next;
                 
@@ -914,48 +1373,173 @@ void writeParseTableToHtml(ParseTable* parseTable, Grammar* grammar, const char*
     printf("Parse table has been written to %s (HTML format for browser viewing)\n", filename);
 }
 
-// Define parse tree node structure
-typedef struct ParseTreeNode {
-    bool isTerminal;
-    int symbolIndex;
-    int lineNumber;
-    char lexeme[100];
-    struct ParseTreeNode* parent;
-    struct ParseTreeNode* firstChild;
-    struct ParseTreeNode* nextSibling;
-} ParseTreeNode;
-
-// Define parser stack element
-typedef struct StackElement {
-    bool isTerminal;
-    int symbolIndex;
-    ParseTreeNode* node;
-    struct StackElement* next;
-} StackElement;
-
-// Define stack structure
-typedef struct {
-    StackElement* top;
-} ParserStack;
-
-// Define token from lexer
-typedef struct {
-    char lexeme[100];
-    char token[50];
-    int lineNumber;
-} Token;
-
-// Function prototypes
-ParserStack* createStack();
-void push(ParserStack* stack, bool isTerminal, int symbolIndex, ParseTreeNode* node);
-StackElement* pop(ParserStack* stack);
-ParseTreeNode* createNode(bool isTerminal, int symbolIndex, int lineNumber, const char* lexeme);
-void addChild(ParseTreeNode* parent, ParseTreeNode* child);
-void printStackContents(ParserStack* stack, Grammar* grammar);
-void printParseTree(ParseTreeNode* node, Grammar* grammar, int depth);
-void inorderTraversal(ParseTreeNode* node, Grammar* grammar, FILE* outFile);
-Token* readTokensFromFile(const char* filename, int* numTokens);
-void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, const char* parseTreeFile);
+// Generate a direct-coded recursive-descent parser with one C function per non-terminal.
+// Each function switches on the lookahead terminal id using the same predictions as the
+// parse table, so the generated parser builds exactly the tree runPredictiveParser builds.
+// The output is meant to be included into this file by compiling with -DUSE_RD_PARSER.
+void generateRecursiveDescentParser(Grammar* grammar, ParseTable* parseTable, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        printf("Error opening file %s for writing\n", filename);
+        return;
+    }
+    
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    int dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    int startIndex = findNonTerminalIndex(grammar, grammar->startSymbol);
+    
+    fprintf(file, "// Recursive-descent parser generated by generateRecursiveDescentParser, do not edit.\n");
+    fprintf(file, "// Regenerate it whenever grammar.txt changes.\n\n");
+    fprintf(file, "#define RD_NUM_TERMINALS %d\n", grammar->numTerminals);
+    fprintf(file, "#define RD_NUM_NONTERMINALS %d\n", grammar->numNonTerminals);
+    fprintf(file, "#define RD_NUM_RULES %d\n", grammar->numRules);
+    fprintf(file, "#define RD_DOLLAR %d\n\n", dollarIndex);
+    
+    // Runtime support shared by all generated functions
+    fprintf(file, "typedef struct {\n");
+    fprintf(file, "    Token* tokens;\n");
+    fprintf(file, "    int pos;\n");
+    fprintf(file, "    bool error;\n");
+    fprintf(file, "} RDParser;\n\n");
+    
+    fprintf(file, "// Append a child after prev without walking the sibling list\n");
+    fprintf(file, "static inline ParseTreeNode* rdChild(ParseTreeNode* parent, ParseTreeNode* prev, bool isTerminal, int symbolIndex) {\n");
+    fprintf(file, "    ParseTreeNode* child = createNode(isTerminal, symbolIndex, 0, NULL);\n");
+    fprintf(file, "    child->parent = parent;\n");
+    fprintf(file, "    if (prev == NULL) {\n");
+    fprintf(file, "        parent->firstChild = child;\n");
+    fprintf(file, "    } else {\n");
+    fprintf(file, "        prev->nextSibling = child;\n");
+    fprintf(file, "    }\n");
+    fprintf(file, "    return child;\n");
+    fprintf(file, "}\n\n");
+    
+    fprintf(file, "static inline void rdMatch(RDParser* p, ParseTreeNode* node, int terminal) {\n");
+    fprintf(file, "    Token* token = &p->tokens[p->pos];\n");
+    fprintf(file, "    if (token->terminalIndex == terminal) {\n");
+    fprintf(file, "        snprintf(node->lexeme, sizeof(node->lexeme), \"%%s\", token->lexeme);\n");
+    fprintf(file, "        node->lineNumber = token->lineNumber;\n");
+    fprintf(file, "        p->pos++;\n");
+    fprintf(file, "    } else {\n");
+    fprintf(file, "        p->error = true; // missing terminal, leave it unmatched\n");
+    fprintf(file, "    }\n");
+    fprintf(file, "}\n\n");
+    
+    // Prototypes
+    for (int i = 0; i < grammar->numNonTerminals; i++) {
+        fprintf(file, "static void rd_%s(RDParser* p, ParseTreeNode* node);\n", grammar->nonTerminals[i]);
+    }
+    fprintf(file, "\n");
+    
+    // One function per non-terminal
+    for (int A = 0; A < grammar->numNonTerminals; A++) {
+        fprintf(file, "static void rd_%s(RDParser* p, ParseTreeNode* node) {\n", grammar->nonTerminals[A]);
+        fprintf(file, "    for (;;) {\n");
+        fprintf(file, "        switch (p->tokens[p->pos].terminalIndex) {\n");
+        
+        // Group lookaheads by the rule they predict
+        for (int r = 1; r <= grammar->numRules; r++) {
+            Symbol* lhs = grammar->rules[r]->symbols->head;
+            if (lhs->id.nonTerminal != A) continue;
+            
+            bool used = false;
+            for (int j = 0; j < grammar->numTerminals; j++) {
+                if (getParseTableEntry(parseTable, A, j) == r) {
+                    fprintf(file, "        case %d: // %s\n", j, grammar->terminals[j]);
+                    used = true;
+                }
+            }
+            if (!used) continue;
+            
+            fprintf(file, "        {\n");
+            fprintf(file, "            // rule %d: %s ->", r, grammar->nonTerminals[A]);
+            for (Symbol* sym = lhs->next; sym != NULL; sym = sym->next) {
+                fprintf(file, " %s", sym->isTerminal ? grammar->terminals[sym->id.terminal]
+                                                     : grammar->nonTerminals[sym->id.nonTerminal]);
+            }
+            fprintf(file, "\n");
+            
+            // Create every child first, in order, exactly like the table-driven parser
+            int count = 0;
+            for (Symbol* sym = lhs->next; sym != NULL; sym = sym->next, count++) {
+                int id = sym->isTerminal ? sym->id.terminal : sym->id.nonTerminal;
+                if (count == 0 && sym->isTerminal && sym->id.terminal == epsilonIndex) {
+                    fprintf(file, "            rdChild(node, NULL, true, %d);\n", id);
+                } else if (count == 0) {
+                    fprintf(file, "            ParseTreeNode* c0 = rdChild(node, NULL, %s, %d);\n",
+                            sym->isTerminal ? "true" : "false", id);
+                } else {
+                    fprintf(file, "            ParseTreeNode* c%d = rdChild(node, c%d, %s, %d);\n",
+                            count, count - 1, sym->isTerminal ? "true" : "false", id);
+                }
+            }
+            
+            // Then expand them left to right; a trailing self reference becomes a loop
+            bool loops = false;
+            count = 0;
+            for (Symbol* sym = lhs->next; sym != NULL; sym = sym->next, count++) {
+                if (sym->isTerminal) {
+                    if (sym->id.terminal == epsilonIndex) continue;
+                    fprintf(file, "            rdMatch(p, c%d, %d);\n", count, sym->id.terminal);
+                } else if (sym->next == NULL && sym->id.nonTerminal == A) {
+                    fprintf(file, "            node = c%d;\n", count);
+                    loops = true;
+                } else {
+                    fprintf(file, "            rd_%s(p, c%d);\n", grammar->nonTerminals[sym->id.nonTerminal], count);
+                }
+            }
+            fprintf(file, loops ? "            continue;\n" : "            return;\n");
+            fprintf(file, "        }\n");
+        }
+        
+        // Synch entries pop the non-terminal, and so does an error on the end marker
+        bool anySynch = false;
+        for (int j = 0; j < grammar->numTerminals; j++) {
+            int entry = getParseTableEntry(parseTable, A, j);
+            if (entry == PARSE_TABLE_SYNCH || (entry == PARSE_TABLE_ERROR && j == dollarIndex)) {
+                fprintf(file, "        case %d: // %s\n", j, grammar->terminals[j]);
+                anySynch = true;
+            }
+        }
+        if (anySynch) {
+            fprintf(file, "            p->error = true;\n");
+            fprintf(file, "            return;\n");
+        }
+        
+        // Unknown tokens are skipped silently, errors skip the token and retry
+        fprintf(file, "        case -1:\n");
+        fprintf(file, "            p->pos++;\n");
+        fprintf(file, "            continue;\n");
+        fprintf(file, "        default:\n");
+        fprintf(file, "            p->error = true;\n");
+        fprintf(file, "            p->pos++;\n");
+        fprintf(file, "            continue;\n");
+        fprintf(file, "        }\n");
+        fprintf(file, "    }\n");
+        fprintf(file, "}\n\n");
+    }
+    
+    // Entry point
+    fprintf(file, "ParseTreeNode* parseTokensRecursiveDescent(Grammar* grammar, Token* tokens, int numTokens, bool* hadError) {\n");
+    fprintf(file, "    if (grammar->numTerminals != RD_NUM_TERMINALS || grammar->numNonTerminals != RD_NUM_NONTERMINALS ||\n");
+    fprintf(file, "        grammar->numRules != RD_NUM_RULES) {\n");
+    fprintf(file, "        printf(\"Error: %s does not match the grammar, regenerate it\\n\");\n", filename);
+    fprintf(file, "        exit(1);\n");
+    fprintf(file, "    }\n\n");
+    fprintf(file, "    RDParser p = { tokens, 0, false };\n");
+    fprintf(file, "    ParseTreeNode* root = createNode(false, %d, 0, NULL);\n", startIndex);
+    fprintf(file, "    rd_%s(&p, root);\n\n", grammar->nonTerminals[startIndex]);
+    fprintf(file, "    // Whatever is left before the end marker is an error\n");
+    fprintf(file, "    if (p.pos < numTokens - 1) {\n");
+    fprintf(file, "        p.error = true;\n");
+    fprintf(file, "    }\n");
+    fprintf(file, "    if (hadError) *hadError = p.error;\n");
+    fprintf(file, "    return root;\n");
+    fprintf(file, "}\n");
+    
+    fclose(file);
+    printf("Recursive-descent parser has been written to %s\n", filename);
+}
 
 // Initialize the parser stack
 ParserStack* createStack() {
@@ -998,6 +1582,8 @@ ParseTreeNode* createNode(bool isTerminal, int symbolIndex, int lineNumber, cons
     } else {
         node->lexeme[0] = '\0';
     }
+    node->ruleNumber = -1;
+    node->collapsedRule = -1;
     node->parent = NULL;
     node->firstChild = NULL;
     node->nextSibling = NULL;
@@ -1021,6 +1607,38 @@ void addChild(ParseTreeNode* parent, ParseTreeNode* child) {
     }
 }
 
+// Compact tree construction: after node was expanded or lost a child, drop it if it derived
+// nothing and fold it into its child if only one child is left. The child takes the node's
+// place in its parent and remembers the outermost rule in collapsedRule. The root is kept.
+void compactParseTreeNode(ParseTreeNode* node) {
+    while (node != NULL && node->parent != NULL && !node->isTerminal) {
+        ParseTreeNode* parent = node->parent;
+        ParseTreeNode* child = node->firstChild;
+        
+        if (child != NULL && child->nextSibling != NULL) return;
+        
+        // Find the link that points at node
+        ParseTreeNode** link = &parent->firstChild;
+        while (*link != node) {
+            link = &(*link)->nextSibling;
+        }
+        
+        if (child == NULL) {
+            // Epsilon subtree: unlink it, the parent may now be compactable itself
+            *link = node->nextSibling;
+            free(node);
+            node = parent;
+        } else {
+            child->parent = parent;
+            child->nextSibling = node->nextSibling;
+            child->collapsedRule = node->collapsedRule != -1 ? node->collapsedRule : node->ruleNumber;
+            *link = child;
+            free(node);
+            return;
+        }
+    }
+}
+
 // Print the contents of the stack (for debugging)
 void printStackContents(ParserStack* stack, Grammar* grammar) {
     printf("Stack: ");
@@ -1036,70 +1654,347 @@ void printStackContents(ParserStack* stack, Grammar* grammar) {
     printf("\n");
 }
 
+// Buffered writer for the parse tree dumps. Lines are formatted straight into one large
+// buffer and handed to write() when it fills, instead of going through stdio per field.
+#define TREE_WRITER_BUFFER (1 << 16)
+
+typedef struct {
+    int fd;
+    size_t used;
+    char data[TREE_WRITER_BUFFER];
+} TreeWriter;
+
+static void flushTreeWriter(TreeWriter* writer) {
+    size_t done = 0;
+    while (done < writer->used) {
+        ssize_t n = write(writer->fd, writer->data + done, writer->used - done);
+        if (n <= 0) {
+            printf("Error writing parse tree\n");
+            break;
+        }
+        done += (size_t)n;
+    }
+    writer->used = 0;
+}
+
+// Start writing to the file behind a stdio stream, after whatever it has buffered
+static TreeWriter* openTreeWriter(FILE* file) {
+    fflush(file);
+    TreeWriter* writer = (TreeWriter*)malloc(sizeof(TreeWriter));
+    writer->fd = fileno(file);
+    writer->used = 0;
+    return writer;
+}
+
+static void closeTreeWriter(TreeWriter* writer) {
+    flushTreeWriter(writer);
+    free(writer);
+}
+
+static inline void writeBytes(TreeWriter* writer, const char* bytes, size_t length) {
+    while (length > 0) {
+        if (writer->used == TREE_WRITER_BUFFER) flushTreeWriter(writer);
+        size_t chunk = TREE_WRITER_BUFFER - writer->used;
+        if (chunk > length) chunk = length;
+        memcpy(writer->data + writer->used, bytes, chunk);
+        writer->used += chunk;
+        bytes += chunk;
+        length -= chunk;
+    }
+}
+
+static inline void writeSpaces(TreeWriter* writer, size_t count) {
+    while (count > 0) {
+        if (writer->used == TREE_WRITER_BUFFER) flushTreeWriter(writer);
+        size_t chunk = TREE_WRITER_BUFFER - writer->used;
+        if (chunk > count) chunk = count;
+        memset(writer->data + writer->used, ' ', chunk);
+        writer->used += chunk;
+        count -= chunk;
+    }
+}
+
+// Same output as "%-*s": the string, then spaces up to width (never truncated)
+static inline void writePadded(TreeWriter* writer, const char* text, size_t width) {
+    size_t length = strlen(text);
+    writeBytes(writer, text, length);
+    if (length < width) writeSpaces(writer, width - length);
+}
+
+// Same output as "%-*d"
+static inline void writePaddedInt(TreeWriter* writer, int value, size_t width) {
+    char digits[12];
+    char* p = digits + sizeof(digits);
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) *--p = '-';
+    size_t length = (size_t)(digits + sizeof(digits) - p);
+    writeBytes(writer, p, length);
+    if (length < width) writeSpaces(writer, width - length);
+}
+
+#define WRITE_LITERAL(writer, text) writeBytes((writer), (text), sizeof(text) - 1)
+
+// Explicit traversal stack shared by the tree writers, so deep right-recursive chains
+// (otherStmts, moreFields, ...) cannot overflow the call stack
+typedef struct {
+    ParseTreeNode* node;
+    int tag;
+} TreeWalkEntry;
+
+typedef struct {
+    TreeWalkEntry* entries;
+    int top;
+    int capacity;
+} TreeWalkStack;
+
+static inline void pushTreeWalk(TreeWalkStack* stack, ParseTreeNode* node, int tag) {
+    if (stack->top == stack->capacity) {
+        stack->capacity = stack->capacity ? stack->capacity * 2 : 256;
+        stack->entries = (TreeWalkEntry*)realloc(stack->entries, stack->capacity * sizeof(TreeWalkEntry));
+    }
+    stack->entries[stack->top].node = node;
+    stack->entries[stack->top].tag = tag;
+    stack->top++;
+}
+
 // Print the parse tree (for debugging)
 void printParseTree(ParseTreeNode* node, Grammar* grammar, int depth) {
     if (node == NULL) return;
     
-    // Print indentation
-    for (int i = 0; i < depth; i++) {
-        printf("  ");
-    }
+    TreeWriter* writer = openTreeWriter(stdout);
+    TreeWalkStack stack = {NULL, 0, 0};
     
-    // Print node info
-    if (node->isTerminal) {
-        printf("%s", grammar->terminals[node->symbolIndex]);
-        if (node->lexeme[0] != '\0') {
-            printf(" (Lexeme: %s, Line: %d)", node->lexeme, node->lineNumber);
+    // Entries are (node, depth); nodes below the starting one also stand for their later siblings
+    pushTreeWalk(&stack, node, depth);
+    while (stack.top > 0) {
+        TreeWalkEntry entry = stack.entries[--stack.top];
+        ParseTreeNode* current = entry.node;
+        
+        if (entry.tag > depth && current->nextSibling != NULL) {
+            pushTreeWalk(&stack, current->nextSibling, entry.tag);
         }
-    } else {
-        printf("%s", grammar->nonTerminals[node->symbolIndex]);
+        if (current->firstChild != NULL) {
+            pushTreeWalk(&stack, current->firstChild, entry.tag + 1);
+        }
+        
+        // Print indentation and node info
+        writeSpaces(writer, (size_t)entry.tag * 2);
+        if (current->isTerminal) {
+            writePadded(writer, grammar->terminals[current->symbolIndex], 0);
+            if (current->lexeme[0] != '\0') {
+                WRITE_LITERAL(writer, " (Lexeme: ");
+                writePadded(writer, current->lexeme, 0);
+                WRITE_LITERAL(writer, ", Line: ");
+                writePaddedInt(writer, current->lineNumber, 0);
+                WRITE_LITERAL(writer, ")");
+            }
+        } else {
+            writePadded(writer, grammar->nonTerminals[current->symbolIndex], 0);
+        }
+        WRITE_LITERAL(writer, "\n");
     }
-    printf("\n");
     
-    // Print children
-    ParseTreeNode* child = node->firstChild;
-    while (child != NULL) {
-        printParseTree(child, grammar, depth + 1);
-        child = child->nextSibling;
-    }
+    free(stack.entries);
+    closeTreeWriter(writer);
 }
 
-// Correct inorder traversal for n-ary trees
+#define WALK_VISIT 0     // the node's subtree
+#define WALK_SIBLINGS 1  // the node's subtree, then those of its later siblings
+#define WALK_EMIT 2      // the node's own line
+
+// Correct inorder traversal for n-ary trees: leftmost child's subtree, the node itself,
+// then the subtrees of the remaining children
 void inorderTraversal(ParseTreeNode* node, Grammar* grammar, FILE* outFile) {
     if (node == NULL) return;
     
-    // Process leftmost child first
-    if (node->firstChild != NULL) {
-        inorderTraversal(node->firstChild, grammar, outFile);
-    }
+    TreeWriter* writer = openTreeWriter(outFile);
+    TreeWalkStack stack = {NULL, 0, 0};
     
-    // Process current node
-    if (node->isTerminal) {
-        if (node->lexeme[0] != '\0') {
-            fprintf(outFile, "%-20s", grammar->terminals[node->symbolIndex]);
-            fprintf(outFile, "Line: %-4d", node->lineNumber);
-            fprintf(outFile, "Lexeme: %-20s\n", node->lexeme);
+    pushTreeWalk(&stack, node, WALK_VISIT);
+    while (stack.top > 0) {
+        TreeWalkEntry entry = stack.entries[--stack.top];
+        ParseTreeNode* current = entry.node;
+        
+        if (entry.tag == WALK_SIBLINGS) {
+            if (current->nextSibling != NULL) pushTreeWalk(&stack, current->nextSibling, WALK_SIBLINGS);
+            entry.tag = WALK_VISIT;
+        }
+        
+        if (entry.tag == WALK_VISIT && current->firstChild != NULL) {
+            if (current->firstChild->nextSibling != NULL) {
+                pushTreeWalk(&stack, current->firstChild->nextSibling, WALK_SIBLINGS);
+            }
+            pushTreeWalk(&stack, current, WALK_EMIT);
+            pushTreeWalk(&stack, current->firstChild, WALK_VISIT);
+            continue;
+        }
+        
+        // Process current node
+        if (current->isTerminal) {
+            if (current->lexeme[0] != '\0') {
+                writePadded(writer, grammar->terminals[current->symbolIndex], 20);
+                WRITE_LITERAL(writer, "Line: ");
+                writePaddedInt(writer, current->lineNumber, 4);
+                WRITE_LITERAL(writer, "Lexeme: ");
+                writePadded(writer, current->lexeme, 20);
+                WRITE_LITERAL(writer, "\n");
+            }
+        } else {
+            writePadded(writer, grammar->nonTerminals[current->symbolIndex], 20);
+            WRITE_LITERAL(writer, "Line: ---   Internal Node\n");
         }
-    } else {
-        fprintf(outFile, "%-20s", grammar->nonTerminals[node->symbolIndex]);
-        fprintf(outFile, "Line: ---");
-        fprintf(outFile, "   Internal Node\n");
     }
     
-    // Process remaining siblings of the leftmost child
-    if (node->firstChild != NULL) {
-        ParseTreeNode* sibling = node->firstChild->nextSibling;
-        while (sibling != NULL) {
-            inorderTraversal(sibling, grammar, outFile);
-            sibling = sibling->nextSibling;
+    free(stack.entries);
+    closeTreeWriter(writer);
+}
+
+// Free a parse tree and all of its descendants. The stack holds sibling chains
+// still to be freed.
+void freeParseTree(ParseTreeNode* node) {
+    if (node == NULL) return;
+    
+    TreeWalkStack stack = {NULL, 0, 0};
+    pushTreeWalk(&stack, node, 0);
+    while (stack.top > 0) {
+        node = stack.entries[--stack.top].node;
+        while (node != NULL) {
+            ParseTreeNode* next = node->nextSibling;
+            if (node->firstChild != NULL) pushTreeWalk(&stack, node->firstChild, 0);
+            free(node);
+            node = next;
         }
     }
+    free(stack.entries);
 }
 
-// // Read tokens from lexer output file
-// Token* readTokensFromFile(const char* filename, int* numTokens) {
-//     FILE* file = fopen(filename, "r");
-//     if (!file) {
+// Structural comparison of two parse trees (symbols, lexemes and line numbers).
+// The two stacks hold matching sibling chains still to be compared.
+bool parseTreesEqual(ParseTreeNode* a, ParseTreeNode* b) {
+    TreeWalkStack left = {NULL, 0, 0};
+    TreeWalkStack right = {NULL, 0, 0};
+    bool equal = true;
+    
+    pushTreeWalk(&left, a, 0);
+    pushTreeWalk(&right, b, 0);
+    while (equal && left.top > 0) {
+        a = left.entries[--left.top].node;
+        b = right.entries[--right.top].node;
+        while (a != NULL && b != NULL) {
+            if (a->isTerminal != b->isTerminal || a->symbolIndex != b->symbolIndex ||
+                a->lineNumber != b->lineNumber || strcmp(a->lexeme, b->lexeme) != 0) {
+                break;
+            }
+            if (a->firstChild != NULL || b->firstChild != NULL) {
+                pushTreeWalk(&left, a->firstChild, 0);
+                pushTreeWalk(&right, b->firstChild, 0);
+            }
+            a = a->nextSibling;
+            b = b->nextSibling;
+        }
+        equal = a == NULL && b == NULL;
+    }
+    
+    free(left.entries);
+    free(right.entries);
+    return equal;
+}
+
+// Number the nodes in preorder and group their ids by symbol
+ParseTreeIndex* buildParseTreeIndex(ParseTreeNode* root, Grammar* grammar) {
+    ParseTreeIndex* index = (ParseTreeIndex*)malloc(sizeof(ParseTreeIndex));
+    index->root = root;
+    index->ownsTree = false;
+    index->numNodes = 0;
+    index->numTerminals = grammar->numTerminals;
+    index->numSymbols = grammar->numTerminals + grammar->numNonTerminals;
+    index->offsets = (int*)calloc(index->numSymbols + 1, sizeof(int));
+    
+    int capacity = 1024;
+    index->nodes = (ParseTreeNode**)malloc(capacity * sizeof(ParseTreeNode*));
+    
+    // An entry stands for a node and, unless it is the root, its later siblings
+    TreeWalkStack stack = {NULL, 0, 0};
+    if (root != NULL) pushTreeWalk(&stack, root, 0);
+    while (stack.top > 0) {
+        TreeWalkEntry entry = stack.entries[--stack.top];
+        ParseTreeNode* current = entry.node;
+        
+        if (index->numNodes == capacity) {
+            capacity *= 2;
+            index->nodes = (ParseTreeNode**)realloc(index->nodes, capacity * sizeof(ParseTreeNode*));
+        }
+        index->nodes[index->numNodes++] = current;
+        index->offsets[(current->isTerminal ? 0 : index->numTerminals) + current->symbolIndex + 1]++;
+        
+        if (entry.tag && current->nextSibling != NULL) pushTreeWalk(&stack, current->nextSibling, 1);
+        if (current->firstChild != NULL) pushTreeWalk(&stack, current->firstChild, 1);
+    }
+    free(stack.entries);
+    
+    for (int k = 0; k < index->numSymbols; k++) {
+        index->offsets[k + 1] += index->offsets[k];
+    }
+    
+    // Filling in id order keeps every posting list sorted
+    int* fill = (int*)malloc(index->numSymbols * sizeof(int));
+    memcpy(fill, index->offsets, index->numSymbols * sizeof(int));
+    index->postings = (int*)malloc((index->numNodes > 0 ? index->numNodes : 1) * sizeof(int));
+    for (int id = 0; id < index->numNodes; id++) {
+        ParseTreeNode* node = index->nodes[id];
+        index->postings[fill[(node->isTerminal ? 0 : index->numTerminals) + node->symbolIndex]++] = id;
+    }
+    free(fill);
+    
+    return index;
+}
+
+void freeParseTreeIndex(ParseTreeIndex* index) {
+    if (index == NULL) return;
+    if (index->ownsTree) freeParseTree(index->root);
+    free(index->nodes);
+    free(index->offsets);
+    free(index->postings);
+    free(index);
+}
+
+// Ids of all nodes with the given symbol, in document order. Returns how many there are.
+int queryTerminalNodes(const ParseTreeIndex* index, int terminal, const int** ids) {
+    int key = terminal;
+    *ids = index->postings + index->offsets[key];
+    return index->offsets[key + 1] - index->offsets[key];
+}
+
+int queryNonTerminalNodes(const ParseTreeIndex* index, int nonTerminal, const int** ids) {
+    int key = index->numTerminals + nonTerminal;
+    *ids = index->postings + index->offsets[key];
+    return index->offsets[key + 1] - index->offsets[key];
+}
+
+// Look a symbol up by name ("funCallStmt", "TK_FIELDID"); unknown names match nothing
+int querySymbolNodes(const ParseTreeIndex* index, Grammar* grammar, const char* symbol, const int** ids) {
+    int terminal = findTerminalIndex(grammar, symbol);
+    if (terminal >= 0) return queryTerminalNodes(index, terminal, ids);
+    
+    int nonTerminal = findNonTerminalIndex(grammar, symbol);
+    if (nonTerminal >= 0) return queryNonTerminalNodes(index, nonTerminal, ids);
+    
+    *ids = index->postings;
+    return 0;
+}
+
+static inline ParseTreeNode* indexedNode(const ParseTreeIndex* index, int id) {
+    return index->nodes[id];
+}
+
+// // Read tokens from lexer output file
+// Token* readTokensFromFile(const char* filename, int* numTokens) {
+//     FILE* file = fopen(filename, "r");
+//     if (!file) {
 //         printf("Error opening token file: %s\n", filename);
 //         exit(1);
 //     }
@@ -1156,6 +2051,42 @@ void inorderTraversal(ParseTreeNode* node, Grammar* grammar, FILE* outFile) {
 //     return tokens;
 // }
 
+// Parse one line of lexer output into token. Returns false for comments and
+// lines that are not tokens.
+static bool parseTokenLine(char* line, Token* token) {
+    // Remove CR if present (for CRLF files)
+    size_t len = strlen(line);
+    if (len > 0 && line[len-1] == '\n') {
+        line[len-1] = '\0';
+        len--;
+        if (len > 0 && line[len-1] == '\r') {
+            line[len-1] = '\0';
+            len--;
+        }
+    }
+    
+    // Skip comment tokens
+    if (strstr(line, "Token TK_COMMENT") != NULL) {
+        return false;
+    }
+    
+    int line_no;
+    char lexeme[100] = {0};
+    char tokenName[50] = {0};
+    
+    // Try to parse the line
+    if (sscanf(line, "Line no. %d Lexeme %s Token %s", &line_no, lexeme, tokenName) != 3) {
+        return false;
+    }
+    
+    token->lineNumber = line_no;
+    strncpy(token->lexeme, lexeme, sizeof(token->lexeme) - 1);
+    token->lexeme[sizeof(token->lexeme) - 1] = '\0'; // Ensure null termination
+    strncpy(token->token, tokenName, sizeof(token->token) - 1);
+    token->token[sizeof(token->token) - 1] = '\0'; // Ensure null termination
+    return true;
+}
+
 Token* readTokensFromFile(const char* filename, int* numTokens) {
     FILE* file = fopen(filename, "r");
     if (!file) {
@@ -1196,33 +2127,7 @@ Token* readTokensFromFile(const char* filename, int* numTokens) {
     int index = 0;
     
     while (fgets(line, sizeof(line), file) && index < count) {
-        // Remove CR if present (for CRLF files)
-        size_t len = strlen(line);
-        if (len > 0 && line[len-1] == '\n') {
-            line[len-1] = '\0';
-            len--;
-            if (len > 0 && line[len-1] == '\r') {
-                line[len-1] = '\0';
-                len--;
-            }
-        }
-        
-        // Skip comment tokens
-        if (strstr(line, "Token TK_COMMENT") != NULL) {
-            continue;
-        }
-        
-        int line_no;
-        char lexeme[100] = {0};
-        char token[50] = {0};
-        
-        // Try to parse the line
-        if (sscanf(line, "Line no. %d Lexeme %s Token %s", &line_no, lexeme, token) == 3) {
-            tokens[index].lineNumber = line_no;
-            strncpy(tokens[index].lexeme, lexeme, sizeof(tokens[index].lexeme) - 1);
-            tokens[index].lexeme[sizeof(tokens[index].lexeme) - 1] = '\0'; // Ensure null termination
-            strncpy(tokens[index].token, token, sizeof(tokens[index].token) - 1);
-            tokens[index].token[sizeof(tokens[index].token) - 1] = '\0'; // Ensure null termination
+        if (parseTokenLine(line, &tokens[index])) {
             index++;
         }
     }
@@ -1240,112 +2145,179 @@ Token* readTokensFromFile(const char* filename, int* numTokens) {
     return tokens;
 }
 
-// The main parsing function
-void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, const char* parseTreeFile) {
+// Resolve the terminal index of every token once, so the parser never compares token names
+void resolveTokenTerminals(Grammar* grammar, Token* tokens, int numTokens) {
+    for (int i = 0; i < numTokens; i++) {
+        tokens[i].terminalIndex = findTerminalIndex(grammar, tokens[i].token);
+    }
+}
+
+// Decide a conflicting cell by walking its lookahead DFA over the tokens after pos.
+// Edges that were never taken are simulated once and cached, so repeated decisions
+// cost one table step per lookahead token.
+int adaptivePredict(AdaptivePredictor* predictor, int decisionIndex, Token* tokens, int pos, int numTokens) {
+    LLDecision* decision = &predictor->decisions[decisionIndex];
+    int s = 0;
+    predictor->predictions++;
+    
+    for (int i = pos + 1; decision->states[s].prediction == 0; i++) {
+        LookaheadDFAState* state = &decision->states[s];
+        if (i >= numTokens) {
+            return llLowestRule(state->configs, state->numConfigs);
+        }
+        
+        int t = tokens[i].terminalIndex;
+        if (t < 0) {
+            return decision->staticRule;
+        }
+        
+        int next = state->next[t];
+        if (next < 0) {
+            LLConfigSet from = {state->configs, state->numConfigs, state->numConfigs};
+            LLConfigSet moved = {NULL, 0, 0};
+            llMove(predictor, &from, t, &moved);
+            int depth = state->depth + 1;
+            next = llAddState(predictor, decision, &moved, depth);
+            decision->states[s].next[t] = next;  // states may have moved
+            predictor->simulations++;
+        }
+        s = next;
+    }
+    
+    // No rule survives: let the table's rule run into the usual error recovery
+    return decision->states[s].prediction > 0 ? decision->states[s].prediction : decision->staticRule;
+}
+
+// Predictive LL(1) parsing loop shared by every table-driven entry point.
+// With a predictor, conflicting cells are decided by adaptivePredict instead of the table.
+// compactTree elides epsilon leaves and collapses single-child chains while the tree is built.
+// Steps are logged to logFile unless it is NULL. Returns the root of the parse tree.
+ParseTreeNode* runPredictiveParser(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                                   Token* tokens, int numTokens, bool compactTree, FILE* logFile, bool* hadError) {
+    return runPredictiveParserFrom(grammar, parseTable, predictor, findNonTerminalIndex(grammar, grammar->startSymbol),
+                                   tokens, numTokens, compactTree, logFile, hadError);
+}
+
+// Same as runPredictiveParser, but derives the tokens (ending with TK_DOLLAR) from the
+// non-terminal startIndex instead of the grammar's start symbol
+ParseTreeNode* runPredictiveParserFrom(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                                       int startIndex, Token* tokens, int numTokens, bool compactTree,
+                                       FILE* logFile, bool* hadError) {
     ParserStack* stack = createStack();
     int currentToken = 0;
     
     // Create parse tree root node
-    ParseTreeNode* root = createNode(false, findNonTerminalIndex(grammar, grammar->startSymbol), 0, NULL);
+    ParseTreeNode* root = createNode(false, startIndex, 0, NULL);
     
     // Initialize stack with $ and start symbol
     int dollarIndex = findTerminalIndex(grammar, "TK_DOLLAR");
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
     push(stack, true, dollarIndex, NULL);
-    push(stack, false, findNonTerminalIndex(grammar, grammar->startSymbol), root);
+    push(stack, false, startIndex, root);
     
-    FILE* logFile = fopen("parsing_log.txt", "w");
-    if (!logFile) {
-        printf("Error opening parsing log file\n");
-        return;
+    if (logFile) {
+        fprintf(logFile, "Starting Predictive LL(1) Parsing\n");
+        fprintf(logFile, "=========================================\n\n");
     }
     
-    fprintf(logFile, "Starting Predictive LL(1) Parsing\n");
-    fprintf(logFile, "=========================================\n\n");
-    
     bool error = false;
     
     while (stack->top != NULL) {
         StackElement* X = stack->top;
+        int a_idx = tokens[currentToken].terminalIndex;
         
         // Print current status
-        fprintf(logFile, "Current Token: %s, Lexeme: %s, Line: %d\n", 
-                tokens[currentToken].token, tokens[currentToken].lexeme, tokens[currentToken].lineNumber);
-        
-        fprintf(logFile, "Top of Stack: ");
-        if (X->isTerminal) {
-            fprintf(logFile, "%s (Terminal)\n", grammar->terminals[X->symbolIndex]);
-        } else {
-            fprintf(logFile, "%s (Non-terminal)\n", grammar->nonTerminals[X->symbolIndex]);
+        if (logFile) {
+            fprintf(logFile, "Current Token: %s, Lexeme: %s, Line: %d\n", 
+                    tokens[currentToken].token, tokens[currentToken].lexeme, tokens[currentToken].lineNumber);
+            
+            fprintf(logFile, "Top of Stack: ");
+            if (X->isTerminal) {
+                fprintf(logFile, "%s (Terminal)\n", grammar->terminals[X->symbolIndex]);
+            } else {
+                fprintf(logFile, "%s (Non-terminal)\n", grammar->nonTerminals[X->symbolIndex]);
+            }
         }
         
         // Case 1: X is a terminal
         if (X->isTerminal) {
-            if (strcmp(grammar->terminals[X->symbolIndex], tokens[currentToken].token) == 0) {
+            if (X->symbolIndex == a_idx) {
                 // Match found, pop X and advance input
                 StackElement* popped = pop(stack);
                 if (popped->node != NULL) {
                     // Update node with token information
-                    strncpy(popped->node->lexeme, tokens[currentToken].lexeme, sizeof(popped->node->lexeme) - 1);
+                    snprintf(popped->node->lexeme, sizeof(popped->node->lexeme), "%s", tokens[currentToken].lexeme);
                     popped->node->lineNumber = tokens[currentToken].lineNumber;
                 }
                 free(popped);
                 
-                fprintf(logFile, "Matched terminal %s. Advancing input.\n\n", tokens[currentToken].token);
+                if (logFile) fprintf(logFile, "Matched terminal %s. Advancing input.\n\n", tokens[currentToken].token);
                 currentToken++;
             } else {
                 // Error: X doesn't match current input token
                 error = true;
-                fprintf(logFile, "Error: Expected %s but found %s at line %d\n", 
-                        grammar->terminals[X->symbolIndex], tokens[currentToken].token, tokens[currentToken].lineNumber);
+                if (logFile) {
+                    fprintf(logFile, "Error: Expected %s but found %s at line %d\n", 
+                            grammar->terminals[X->symbolIndex], tokens[currentToken].token, tokens[currentToken].lineNumber);
+                    
+                    // Skip X (error recovery)
+                    fprintf(logFile, "Error recovery: Popping %s from stack\n\n", grammar->terminals[X->symbolIndex]);
+                }
                 
-                // Skip X (error recovery)
                 StackElement* popped = pop(stack);
                 free(popped);
-                
-                fprintf(logFile, "Error recovery: Popping %s from stack\n\n", grammar->terminals[X->symbolIndex]);
             }
         }
         // Case 2: X is a non-terminal
         else {
-            int a_idx = -1;
-            
-            // Find terminal index for current token
-            for (int i = 0; i < grammar->numTerminals; i++) {
-                if (strcmp(grammar->terminals[i], tokens[currentToken].token) == 0) {
-                    a_idx = i;
-                    break;
-                }
-            }
-            
             if (a_idx == -1) {
-                fprintf(logFile, "Error: Unknown token %s at line %d\n", 
-                        tokens[currentToken].token, tokens[currentToken].lineNumber);
+                if (logFile) {
+                    fprintf(logFile, "Error: Unknown token %s at line %d\n", 
+                            tokens[currentToken].token, tokens[currentToken].lineNumber);
+                }
                 currentToken++;
                 continue;
             }
             
-            int rule_num = parseTable->table[X->symbolIndex][a_idx];
+            int rule_num = getParseTableEntry(parseTable, X->symbolIndex, a_idx);
+            
+            // Cells with several candidate rules need more than one token of lookahead
+            if (predictor != NULL && rule_num > 0) {
+                int decision = predictor->decisionOf[X->symbolIndex * grammar->numTerminals + a_idx];
+                if (decision >= 0) {
+                    rule_num = adaptivePredict(predictor, decision, tokens, currentToken, numTokens);
+                }
+            }
+            
+            // Never skip past the end marker, treat it as a synchronizing token instead
+            if (rule_num == PARSE_TABLE_ERROR && a_idx == dollarIndex) {
+                rule_num = PARSE_TABLE_SYNCH;
+            }
             
             // Case 2.1: M[X,a] = valid rule
             if (rule_num > 0) {
+                int lhsIndex = X->symbolIndex;
                 StackElement* popped = pop(stack);
                 ParseTreeNode* parentNode = popped->node;
                 free(popped);
+                parentNode->ruleNumber = rule_num;
                 
                 Rule* rule = grammar->rules[rule_num];
                 Symbol* rhs = rule->symbols->head->next;
                 
-                fprintf(logFile, "Using rule %d: %s -> ", rule_num, grammar->nonTerminals[X->symbolIndex]);
+                if (logFile) fprintf(logFile, "Using rule %d: %s -> ", rule_num, grammar->nonTerminals[lhsIndex]);
                 
                 // Create a linked list of RHS symbols in reverse order (for stack)
                 StackElement* rhsList = NULL;
                 int symbolCount = 0;
                 
                 while (rhs != NULL) {
-                    if (rhs->isTerminal) {
-                        fprintf(logFile, "%s ", grammar->terminals[rhs->id.terminal]);
-                    } else {
-                        fprintf(logFile, "%s ", grammar->nonTerminals[rhs->id.nonTerminal]);
+                    if (logFile) {
+                        if (rhs->isTerminal) {
+                            fprintf(logFile, "%s ", grammar->terminals[rhs->id.terminal]);
+                        } else {
+                            fprintf(logFile, "%s ", grammar->nonTerminals[rhs->id.nonTerminal]);
+                        }
                     }
                     
                     StackElement* element = (StackElement*)malloc(sizeof(StackElement));
@@ -1364,12 +2336,17 @@ void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int nu
                     
                     rhs = rhs->next;
                 }
-                fprintf(logFile, "\n");
+                if (logFile) fprintf(logFile, "\n");
                 
                 // Special case: Epsilon rule
-                if (symbolCount == 1 && rhsList->isTerminal && 
-                    strcmp(grammar->terminals[rhsList->symbolIndex], "TK_EPS") == 0) {
+                if (symbolCount == 1 && rhsList->isTerminal && rhsList->symbolIndex == epsilonIndex) {
                     // For epsilon, just free the element without pushing
+                    if (compactTree) {
+                        // A compact tree keeps no TK_EPS leaf and no empty non-terminal
+                        parentNode->firstChild = NULL;
+                        free(rhsList->node);
+                        compactParseTreeNode(parentNode);
+                    }
                     free(rhsList);
                 } else {
                     // Push RHS symbols onto stack (already in reverse order)
@@ -1380,25 +2357,34 @@ void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int nu
                         push(stack, element->isTerminal, element->symbolIndex, element->node);
                         free(element);
                     }
+                    
+                    // Unit rule: the child takes the place of the non-terminal
+                    if (compactTree && symbolCount == 1) {
+                        compactParseTreeNode(parentNode);
+                    }
                 }
                 
-                fprintf(logFile, "Stack after rule application:\n");
-                StackElement* current = stack->top;
-                while (current != NULL) {
-                    if (current->isTerminal) {
-                        fprintf(logFile, "%s ", grammar->terminals[current->symbolIndex]);
-                    } else {
-                        fprintf(logFile, "%s ", grammar->nonTerminals[current->symbolIndex]);
+                if (logFile) {
+                    fprintf(logFile, "Stack after rule application:\n");
+                    StackElement* current = stack->top;
+                    while (current != NULL) {
+                        if (current->isTerminal) {
+                            fprintf(logFile, "%s ", grammar->terminals[current->symbolIndex]);
+                        } else {
+                            fprintf(logFile, "%s ", grammar->nonTerminals[current->symbolIndex]);
+                        }
+                        current = current->next;
                     }
-                    current = current->next;
+                    fprintf(logFile, "\n\n");
                 }
-                fprintf(logFile, "\n\n");
             }
             // Case 2.2: M[X,a] = synch (error recovery)
-            else if (rule_num == -2) {
+            else if (rule_num == PARSE_TABLE_SYNCH) {
                 error = true;
-                fprintf(logFile, "Error recovery: Synch entry found for %s and %s. Popping non-terminal.\n\n", 
-                        grammar->nonTerminals[X->symbolIndex], tokens[currentToken].token);
+                if (logFile) {
+                    fprintf(logFile, "Error recovery: Synch entry found for %s and %s. Popping non-terminal.\n\n", 
+                            grammar->nonTerminals[X->symbolIndex], tokens[currentToken].token);
+                }
                 
                 StackElement* popped = pop(stack);
                 free(popped);
@@ -1406,24 +2392,51 @@ void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int nu
             // Case 2.3: M[X,a] = error
             else {
                 error = true;
-                fprintf(logFile, "Error: No rule for %s with input %s at line %d\n", 
-                        grammar->nonTerminals[X->symbolIndex], tokens[currentToken].token, tokens[currentToken].lineNumber);
-                
-                // Skip current input token (error recovery)
-                fprintf(logFile, "Error recovery: Skipping input token %s\n\n", tokens[currentToken].token);
+                if (logFile) {
+                    fprintf(logFile, "Error: No rule for %s with input %s at line %d\n", 
+                            grammar->nonTerminals[X->symbolIndex], tokens[currentToken].token, tokens[currentToken].lineNumber);
+                    
+                    // Skip current input token (error recovery)
+                    fprintf(logFile, "Error recovery: Skipping input token %s\n\n", tokens[currentToken].token);
+                }
                 currentToken++;
             }
         }
     }
     
     if (currentToken < numTokens - 1) {
-        fprintf(logFile, "Error: Extra tokens in input starting at line %d\n", tokens[currentToken].lineNumber);
-    } else if (!error) {
-        fprintf(logFile, "Parsing completed successfully!\n");
-    } else {
-        fprintf(logFile, "Parsing completed with errors!\n");
+        error = true;
+        if (logFile) fprintf(logFile, "Error: Extra tokens in input starting at line %d\n", tokens[currentToken].lineNumber);
+    } else if (logFile) {
+        if (!error) {
+            fprintf(logFile, "Parsing completed successfully!\n");
+        } else {
+            fprintf(logFile, "Parsing completed with errors!\n");
+        }
+    }
+    
+    free(stack);
+    if (hadError) *hadError = error;
+    return root;
+}
+
+// The main parsing function. With index set, the tree is kept and *index gets a
+// ParseTreeIndex that owns it (free with freeParseTreeIndex); pass NULL to skip indexing.
+void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, const char* parseTreeFile,
+                 ParseTreeIndex** index) {
+    if (index != NULL) *index = NULL;
+    
+    FILE* logFile = fopen("parsing_log.txt", "w");
+    if (!logFile) {
+        printf("Error opening parsing log file\n");
+        return;
     }
     
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    
+    bool error;
+    ParseTreeNode* root = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, logFile, &error);
+    
     // Print parse tree for debugging
     fprintf(logFile, "\nParse Tree:\n");
     printParseTree(root, grammar, 0);
@@ -1433,6 +2446,7 @@ void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int nu
     if (!traversalFile) {
         printf("Error opening parse tree file\n");
         fclose(logFile);
+        freeParseTree(root);
         return;
     }
     
@@ -1445,41 +2459,3614 @@ void parseTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int nu
     
     fclose(traversalFile);
     fclose(logFile);
+    if (index != NULL) {
+        *index = buildParseTreeIndex(root, grammar);
+        (*index)->ownsTree = true;
+    } else {
+        freeParseTree(root);
+    }
     
     printf("Parsing completed. Check parsing_log.txt for details and %s for parse tree.\n", parseTreeFile);
 }
 
-// Add parsing functionality to main function
-void parseSourceCode(Grammar* grammar, ParseTable* parseTable, const char* tokenFile, const char* parseTreeFile) {
-    int numTokens;
-    Token* tokens = readTokensFromFile(tokenFile, &numTokens);
+// FNV-1a hash of the symbol names and rules, stored in binary parse tree files so a
+// reader never interprets symbol ids against a different grammar
+static uint64_t fingerprintBytes(uint64_t hash, const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t grammarFingerprint(Grammar* grammar) {
+    uint64_t hash = 14695981039346656037ULL;
     
-    printf("Read %d tokens from %s\n", numTokens, tokenFile);
-    parseTokens(grammar, parseTable, tokens, numTokens, parseTreeFile);
+    for (int i = 0; i < grammar->numTerminals; i++) {
+        hash = fingerprintBytes(hash, grammar->terminals[i], strlen(grammar->terminals[i]) + 1);
+    }
+    for (int i = 0; i < grammar->numNonTerminals; i++) {
+        hash = fingerprintBytes(hash, grammar->nonTerminals[i], strlen(grammar->nonTerminals[i]) + 1);
+    }
+    for (int i = 1; i <= grammar->numRules; i++) {
+        for (Symbol* symbol = grammar->rules[i]->symbols->head; symbol != NULL; symbol = symbol->next) {
+            int32_t code = symbol->isTerminal ? symbol->id.terminal : -1 - symbol->id.nonTerminal;
+            hash = fingerprintBytes(hash, &code, sizeof(code));
+        }
+        int32_t endOfRule = INT32_MIN;
+        hash = fingerprintBytes(hash, &endOfRule, sizeof(endOfRule));
+    }
+    return hash;
+}
+
+// Flatten a parse tree into the binary format (see BinaryTreeHeader in parser.h)
+bool writeBinaryParseTree(ParseTreeNode* root, Grammar* grammar, const char* filename) {
+    int numNodes = 0;
+    int lexemeBytes = 0;
     
-    free(tokens);
+    // Preorder numbering with an explicit stack. An entry stands for a node and its later
+    // siblings; the tag is the parent's number.
+    int capacity = 1024;
+    BinaryTreeNode* nodes = (BinaryTreeNode*)malloc(capacity * sizeof(BinaryTreeNode));
+    int* lastChild = (int*)malloc(capacity * sizeof(int));
+    char* pool = NULL;
+    int poolCapacity = 0;
+    TreeWalkStack stack = {NULL, 0, 0};
+    
+    if (root != NULL) pushTreeWalk(&stack, root, -1);
+    while (stack.top > 0) {
+        TreeWalkEntry entry = stack.entries[--stack.top];
+        ParseTreeNode* current = entry.node;
+        int parent = entry.tag;
+        
+        if (numNodes == capacity) {
+            capacity *= 2;
+            nodes = (BinaryTreeNode*)realloc(nodes, capacity * sizeof(BinaryTreeNode));
+            lastChild = (int*)realloc(lastChild, capacity * sizeof(int));
+        }
+        int index = numNodes++;
+        BinaryTreeNode* node = &nodes[index];
+        node->symbol = current->symbolIndex;
+        node->isTerminal = current->isTerminal;
+        node->lineNumber = current->lineNumber;
+        node->ruleNumber = current->ruleNumber;
+        node->parent = parent;
+        node->firstChild = -1;
+        node->nextSibling = -1;
+        node->lexeme = -1;
+        lastChild[index] = -1;
+        
+        if (current->lexeme[0] != '\0') {
+            int length = (int)strlen(current->lexeme) + 1;
+            if (lexemeBytes + length > poolCapacity) {
+                poolCapacity = poolCapacity ? poolCapacity * 2 : 4096;
+                if (poolCapacity < lexemeBytes + length) poolCapacity = lexemeBytes + length;
+                pool = (char*)realloc(pool, poolCapacity);
+            }
+            memcpy(pool + lexemeBytes, current->lexeme, length);
+            node->lexeme = lexemeBytes;
+            lexemeBytes += length;
+        }
+        
+        if (parent >= 0) {
+            if (lastChild[parent] < 0) {
+                nodes[parent].firstChild = index;
+            } else {
+                nodes[lastChild[parent]].nextSibling = index;
+            }
+            lastChild[parent] = index;
+            if (current->nextSibling != NULL) pushTreeWalk(&stack, current->nextSibling, parent);
+        }
+        if (current->firstChild != NULL) pushTreeWalk(&stack, current->firstChild, index);
+    }
+    free(stack.entries);
+    free(lastChild);
+    
+    BinaryTreeHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BINARY_TREE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_TREE_VERSION;
+    header.grammarFingerprint = grammarFingerprint(grammar);
+    header.numNodes = numNodes;
+    header.lexemeBytes = lexemeBytes;
+    header.numTerminals = grammar->numTerminals;
+    header.numNonTerminals = grammar->numNonTerminals;
+    
+    bool ok = false;
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error opening binary parse tree file: %s\n", filename);
+    } else {
+        // pool is still NULL when no node has a lexeme
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(nodes, sizeof(BinaryTreeNode), numNodes, file) == (size_t)numNodes &&
+             (lexemeBytes == 0 || fwrite(pool, 1, lexemeBytes, file) == (size_t)lexemeBytes);
+        if (fclose(file) != 0) ok = false;
+        if (!ok) printf("Error writing binary parse tree file: %s\n", filename);
+    }
+    
+    free(nodes);
+    free(pool);
+    return ok;
 }
 
-// Main function to demonstrate functionality
-int main() {
-    Grammar* grammar = readGrammarFromFile("grammar.txt");
-    printGrammar(grammar);
+// Map a binary parse tree file read-only. The header, node indices and lexeme offsets are
+// checked once here, so callers can follow them without bounds checks.
+BinaryParseTree* mapBinaryParseTree(const char* filename, Grammar* grammar) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Error opening binary parse tree file: %s\n", filename);
+        return NULL;
+    }
     
-    FirstAndFollow* fafl = computeFirstAndFollowSets(grammar);
-    printFirstSets(grammar, fafl);
-    printFollowSets(grammar, fafl);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(BinaryTreeHeader)) {
+        printf("Error: %s is not a binary parse tree file\n", filename);
+        close(fd);
+        return NULL;
+    }
     
-    ParseTable* parseTable = (ParseTable*)malloc(sizeof(ParseTable));
-    createParseTable(fafl, parseTable, grammar);
-    printParseTable(parseTable, grammar);
+    size_t size = (size_t)info.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        printf("Error mapping binary parse tree file: %s\n", filename);
+        return NULL;
+    }
+    
+    const BinaryTreeHeader* header = (const BinaryTreeHeader*)base;
+    const BinaryTreeNode* nodes = (const BinaryTreeNode*)(header + 1);
+    const char* lexemes = (const char*)(nodes + header->numNodes);
+    const char* problem = NULL;
+    
+    if (memcmp(header->magic, BINARY_TREE_MAGIC, sizeof(header->magic)) != 0) {
+        problem = "not a binary parse tree file";
+    } else if (header->version != BINARY_TREE_VERSION) {
+        problem = "unsupported binary parse tree version";
+    } else if (header->grammarFingerprint != grammarFingerprint(grammar)) {
+        problem = "parse tree was written for a different grammar";
+    } else if ((size - sizeof(BinaryTreeHeader)) / sizeof(BinaryTreeNode) < header->numNodes ||
+               size - sizeof(BinaryTreeHeader) - (size_t)header->numNodes * sizeof(BinaryTreeNode) != header->lexemeBytes) {
+        problem = "file size does not match its header";
+    } else if (header->lexemeBytes > 0 && lexemes[header->lexemeBytes - 1] != '\0') {
+        problem = "lexeme pool is not terminated";
+    }
+    
+    int32_t numNodes = (int32_t)header->numNodes;
+    for (int32_t i = 0; problem == NULL && i < numNodes; i++) {
+        const BinaryTreeNode* node = &nodes[i];
+        int32_t limit = node->isTerminal ? grammar->numTerminals : grammar->numNonTerminals;
+        if (node->symbol < 0 || node->symbol >= limit ||
+            node->parent < -1 || node->parent >= i ||
+            (node->firstChild != -1 && node->firstChild != i + 1) ||
+            (node->nextSibling != -1 && (node->nextSibling <= i || node->nextSibling >= numNodes)) ||
+            node->lexeme < -1 || node->lexeme >= (int32_t)header->lexemeBytes) {
+            problem = "corrupt node";
+        }
+    }
+    
+    if (problem != NULL) {
+        printf("Error: %s: %s\n", filename, problem);
+        munmap(base, size);
+        return NULL;
+    }
+    
+    BinaryParseTree* tree = (BinaryParseTree*)malloc(sizeof(BinaryParseTree));
+    tree->base = base;
+    tree->size = size;
+    tree->header = header;
+    tree->nodes = nodes;
+    tree->lexemes = lexemes;
+    return tree;
+}
 
-    // Write parse table to files in different formats for better visualization
-    writeParseTableToCsv(parseTable, grammar, "parse_table_all.csv");
-    writeParseTableToHtml(parseTable, grammar, "parse_table_all.html");
+void unmapBinaryParseTree(BinaryParseTree* tree) {
+    if (tree == NULL) return;
+    munmap(tree->base, tree->size);
+    free(tree);
+}
 
-    // Parse source code using lexer output with hardcoded file names
-    printf("\nParsing source code from lexer output...\n");
-    parseSourceCode(grammar, parseTable, "output_t6.txt", "parse_tree6.txt");
+// inorderTraversal straight off a mapped file, writing the same lines
+void inorderTraversalBinary(const BinaryParseTree* tree, Grammar* grammar, FILE* outFile) {
+    if (tree->header->numNodes == 0) return;
     
-    return 0;
-}
\ No newline at end of file
+    TreeWriter* writer = openTreeWriter(outFile);
+    int capacity = 256;
+    int top = 0;
+    int* stack = (int*)malloc(capacity * 2 * sizeof(int));  // (node, WALK_* tag) pairs
+    
+    stack[top * 2] = 0;
+    stack[top * 2 + 1] = WALK_VISIT;
+    top++;
+    while (top > 0) {
+        top--;
+        int index = stack[top * 2];
+        int tag = stack[top * 2 + 1];
+        const BinaryTreeNode* node = &tree->nodes[index];
+        
+        // At most three entries get pushed per step
+        if (top + 3 > capacity) {
+            capacity *= 2;
+            stack = (int*)realloc(stack, capacity * 2 * sizeof(int));
+        }
+        
+        if (tag == WALK_SIBLINGS) {
+            if (node->nextSibling >= 0) {
+                stack[top * 2] = node->nextSibling;
+                stack[top * 2 + 1] = WALK_SIBLINGS;
+                top++;
+            }
+            tag = WALK_VISIT;
+        }
+        
+        if (tag == WALK_VISIT && node->firstChild >= 0) {
+            int second = tree->nodes[node->firstChild].nextSibling;
+            if (second >= 0) {
+                stack[top * 2] = second;
+                stack[top * 2 + 1] = WALK_SIBLINGS;
+                top++;
+            }
+            stack[top * 2] = index;
+            stack[top * 2 + 1] = WALK_EMIT;
+            top++;
+            stack[top * 2] = node->firstChild;
+            stack[top * 2 + 1] = WALK_VISIT;
+            top++;
+            continue;
+        }
+        
+        if (node->isTerminal) {
+            if (node->lexeme >= 0) {
+                writePadded(writer, grammar->terminals[node->symbol], 20);
+                WRITE_LITERAL(writer, "Line: ");
+                writePaddedInt(writer, node->lineNumber, 4);
+                WRITE_LITERAL(writer, "Lexeme: ");
+                writePadded(writer, tree->lexemes + node->lexeme, 20);
+                WRITE_LITERAL(writer, "\n");
+            }
+        } else {
+            writePadded(writer, grammar->nonTerminals[node->symbol], 20);
+            WRITE_LITERAL(writer, "Line: ---   Internal Node\n");
+        }
+    }
+    
+    free(stack);
+    closeTreeWriter(writer);
+}
+
+// Start a push-mode parse from the grammar's start symbol
+PushParser* createPushParser(Grammar* grammar, ParseTable* parseTable) {
+    PushParser* state = (PushParser*)malloc(sizeof(PushParser));
+    state->grammar = grammar;
+    state->parseTable = parseTable;
+    state->stack = createStack();
+    state->root = createNode(false, findNonTerminalIndex(grammar, grammar->startSymbol), 0, NULL);
+    state->dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    state->epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    state->lastLine = 1;
+    state->tokensFed = 0;
+    state->error = false;
+    
+    push(state->stack, true, state->dollarIndex, NULL);
+    push(state->stack, false, state->root->symbolIndex, state->root);
+    return state;
+}
+
+// Run the parser until token is matched or skipped. Same decisions and error recovery
+// as runPredictiveParser.
+static void pushParserStep(PushParser* state, Token* token, int a_idx) {
+    Grammar* grammar = state->grammar;
+    ParserStack* stack = state->stack;
+    
+    while (stack->top != NULL) {
+        StackElement* X = stack->top;
+        
+        if (X->isTerminal) {
+            StackElement* popped = pop(stack);
+            if (X->symbolIndex == a_idx) {
+                if (popped->node != NULL) {
+                    snprintf(popped->node->lexeme, sizeof(popped->node->lexeme), "%s", token->lexeme);
+                    popped->node->lineNumber = token->lineNumber;
+                }
+                free(popped);
+                return;
+            }
+            // Expected terminal is missing: pop it and retry the token
+            state->error = true;
+            free(popped);
+            continue;
+        }
+        
+        // Unknown tokens are skipped silently, as in runPredictiveParser
+        if (a_idx == -1) return;
+        
+        int rule_num = getParseTableEntry(state->parseTable, X->symbolIndex, a_idx);
+        if (rule_num == PARSE_TABLE_ERROR && a_idx == state->dollarIndex) {
+            rule_num = PARSE_TABLE_SYNCH;
+        }
+        
+        if (rule_num > 0) {
+            StackElement* popped = pop(stack);
+            ParseTreeNode* parentNode = popped->node;
+            free(popped);
+            parentNode->ruleNumber = rule_num;
+            
+            // Children in order, then push them right to left
+            StackElement* rhsList = NULL;
+            for (Symbol* rhs = grammar->rules[rule_num]->symbols->head->next; rhs != NULL; rhs = rhs->next) {
+                StackElement* element = (StackElement*)malloc(sizeof(StackElement));
+                element->isTerminal = rhs->isTerminal;
+                element->symbolIndex = rhs->isTerminal ? rhs->id.terminal : rhs->id.nonTerminal;
+                element->node = createNode(rhs->isTerminal, element->symbolIndex, 0, NULL);
+                addChild(parentNode, element->node);
+                element->next = rhsList;
+                rhsList = element;
+            }
+            
+            bool epsilon = rhsList != NULL && rhsList->next == NULL && rhsList->isTerminal &&
+                           rhsList->symbolIndex == state->epsilonIndex;
+            while (rhsList != NULL) {
+                StackElement* element = rhsList;
+                rhsList = rhsList->next;
+                if (!epsilon) push(stack, element->isTerminal, element->symbolIndex, element->node);
+                free(element);
+            }
+        } else if (rule_num == PARSE_TABLE_SYNCH) {
+            state->error = true;
+            free(pop(stack));
+        } else {
+            // No rule: skip the token
+            state->error = true;
+            return;
+        }
+    }
+    
+    // The stack is empty, so the input should have ended
+    state->error = true;
+}
+
+// Parse the next n tokens. Tokens need not be resolved and are not kept, so the caller
+// can reuse the buffer. Returns false once a syntax error has been seen.
+bool parserFeed(PushParser* state, Token* tokens, int n) {
+    for (int i = 0; i < n; i++) {
+        Token* token = &tokens[i];
+        int a_idx = findTerminalIndex(state->grammar, token->token);
+        
+        state->lastLine = token->lineNumber;
+        state->tokensFed++;
+        pushParserStep(state, token, a_idx);
+    }
+    return !state->error;
+}
+
+// End of input: feed TK_DOLLAR, free the state and hand back the parse tree
+ParseTreeNode* parserFinish(PushParser* state, bool* hadError) {
+    if (state->stack->top != NULL) {
+        Token end;
+        memset(&end, 0, sizeof(end));
+        strncpy(end.lexeme, "$", sizeof(end.lexeme) - 1);
+        strncpy(end.token, DOLLAR_TOKEN, sizeof(end.token) - 1);
+        end.lineNumber = state->lastLine;
+        end.terminalIndex = state->dollarIndex;
+        pushParserStep(state, &end, state->dollarIndex);
+    }
+    
+    ParseTreeNode* root = state->root;
+    if (hadError) *hadError = state->error;
+    
+    while (state->stack->top != NULL) {
+        free(pop(state->stack));
+    }
+    free(state->stack);
+    free(state);
+    return root;
+}
+
+// Leaves that hold a matched token (epsilon and error recovery leaves have no lexeme)
+static void collectTokenLeaves(ParseTreeNode* node, ParseTreeNode*** leaves, int* count, int* capacity) {
+    TreeWalkStack stack = {NULL, 0, 0};
+    
+    pushTreeWalk(&stack, node, 0);
+    while (stack.top > 0) {
+        TreeWalkEntry entry = stack.entries[--stack.top];
+        ParseTreeNode* current = entry.node;
+        
+        if (entry.tag && current->nextSibling != NULL) pushTreeWalk(&stack, current->nextSibling, 1);
+        if (current->firstChild != NULL) pushTreeWalk(&stack, current->firstChild, 1);
+        if (current->isTerminal && current->lexeme[0] != '\0') {
+            if (*count == *capacity) {
+                *capacity = *capacity ? *capacity * 2 : 1024;
+                *leaves = (ParseTreeNode**)realloc(*leaves, *capacity * sizeof(ParseTreeNode*));
+            }
+            (*leaves)[(*count)++] = current;
+        }
+    }
+    free(stack.entries);
+}
+
+static void setDollarToken(Grammar* grammar, Token* token, int lineNumber) {
+    memset(token, 0, sizeof(Token));
+    strncpy(token->lexeme, "$", sizeof(token->lexeme) - 1);
+    strncpy(token->token, DOLLAR_TOKEN, sizeof(token->token) - 1);
+    token->lineNumber = lineNumber;
+    token->terminalIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+}
+
+// First token index whose line is at least line; TK_DOLLAR is never part of a line range
+static int findFirstTokenOnLine(IncrementalParse* inc, int line) {
+    int low = 0, high = inc->numTokens - 1;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (inc->tokens[mid].lineNumber < line) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Replace the tokens on lines firstLine..lastLine with newTokens and move the tokens after
+// them by lineDelta lines. Returns the index of the first new token.
+static int spliceTokens(IncrementalParse* inc, int firstLine, int lastLine, Token* newTokens, int numNew,
+                        int lineDelta) {
+    int first = findFirstTokenOnLine(inc, firstLine);
+    int last = findFirstTokenOnLine(inc, lastLine + 1);
+    int numTokens = inc->numTokens - (last - first) + numNew;
+    
+    if (numTokens > inc->tokenCapacity) {
+        inc->tokenCapacity = numTokens * 2;
+        inc->tokens = (Token*)realloc(inc->tokens, inc->tokenCapacity * sizeof(Token));
+    }
+    memmove(inc->tokens + first + numNew, inc->tokens + last, (inc->numTokens - last) * sizeof(Token));
+    memcpy(inc->tokens + first, newTokens, numNew * sizeof(Token));
+    inc->numTokens = numTokens;
+    
+    for (int i = first + numNew; i < numTokens - 1; i++) {
+        inc->tokens[i].lineNumber += lineDelta;
+    }
+    // TK_DOLLAR stays on the last line
+    inc->tokens[numTokens - 1].lineNumber = numTokens > 1 ? inc->tokens[numTokens - 2].lineNumber : 1;
+    return first;
+}
+
+// First leaf index whose line is at least line
+static int findFirstLeafOnLine(IncrementalParse* inc, int line) {
+    int low = 0, high = inc->numLeaves;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (inc->leaves[mid]->lineNumber < line) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static inline bool isFunctionNode(IncrementalParse* inc, ParseTreeNode* node) {
+    return !node->isTerminal && (node->symbolIndex == inc->functionIndex || node->symbolIndex == inc->mainFunctionIndex);
+}
+
+// Subtrees that can be parsed again on their own
+static inline bool isReparseBoundary(IncrementalParse* inc, ParseTreeNode* node) {
+    return isFunctionNode(inc, node) || (!node->isTerminal && node->symbolIndex == inc->stmtIndex);
+}
+
+// Whether node lies inside ancestor (a reparse boundary). Functions do not nest, so the
+// walk never has to go further up than the function around node.
+static bool isWithin(IncrementalParse* inc, ParseTreeNode* node, ParseTreeNode* ancestor) {
+    for (; node != NULL; node = node->parent) {
+        if (node == ancestor) return true;
+        if (isFunctionNode(inc, node)) return false;
+    }
+    return false;
+}
+
+// Parse the whole edited input again
+static void fullReparse(IncrementalParse* inc) {
+    freeParseTree(inc->root);
+    inc->root = runPredictiveParser(inc->grammar, inc->parseTable, NULL, inc->tokens, inc->numTokens, false, NULL,
+                                    &inc->error);
+    inc->numLeaves = 0;
+    collectTokenLeaves(inc->root, &inc->leaves, &inc->numLeaves, &inc->capacity);
+    inc->reparsedTokens = inc->numTokens - 1;
+}
+
+// Initial full parse; tokens end with TK_DOLLAR and are copied
+IncrementalParse* createIncrementalParse(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens) {
+    IncrementalParse* inc = (IncrementalParse*)malloc(sizeof(IncrementalParse));
+    inc->grammar = grammar;
+    inc->parseTable = parseTable;
+    inc->tokens = (Token*)malloc(numTokens * sizeof(Token));
+    inc->numTokens = numTokens;
+    inc->tokenCapacity = numTokens;
+    inc->root = NULL;
+    inc->leaves = NULL;
+    inc->numLeaves = 0;
+    inc->capacity = 0;
+    inc->stmtIndex = findNonTerminalIndex(grammar, "stmt");
+    inc->functionIndex = findNonTerminalIndex(grammar, "function");
+    inc->mainFunctionIndex = findNonTerminalIndex(grammar, "mainFunction");
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    memcpy(inc->tokens, tokens, numTokens * sizeof(Token));
+    fullReparse(inc);
+    return inc;
+}
+
+void freeIncrementalParse(IncrementalParse* inc) {
+    if (inc == NULL) return;
+    freeParseTree(inc->root);
+    free(inc->tokens);
+    free(inc->leaves);
+    free(inc);
+}
+
+// Apply an edit that replaced source lines firstLine..lastLine with lines
+// firstLine..newLastLine, whose tokens (re-lexed from just those lines) are newTokens.
+// No token spans a line break, so the lexer starts every line in its start state and
+// the rest of the file needs no re-lexing. Only the smallest stmt/function subtree whose
+// first and last tokens lie outside the edit is parsed again and spliced into the tree;
+// if none parses cleanly in place, the whole input is parsed again.
+// Returns true if the edit was handled incrementally.
+bool reparseEditedLines(IncrementalParse* inc, int firstLine, int lastLine, Token* newTokens, int numNew,
+                        int newLastLine) {
+    Grammar* grammar = inc->grammar;
+    int lineDelta = newLastLine - lastLine;
+    int a = findFirstLeafOnLine(inc, firstLine);
+    int b = findFirstLeafOnLine(inc, lastLine + 1);
+    
+    resolveTokenTerminals(grammar, newTokens, numNew);
+    int first = spliceTokens(inc, firstLine, lastLine, newTokens, numNew, lineDelta);
+    
+    // Later tokens move with the lines (nothing to do for edits within lines)
+    if (lineDelta != 0) {
+        for (int i = b; i < inc->numLeaves; i++) {
+            inc->leaves[i]->lineNumber += lineDelta;
+        }
+    }
+    
+    // Error recovery makes subtree boundaries unreliable, so a tree with errors is rebuilt
+    ParseTreeNode* candidate = !inc->error && a > 0 && b < inc->numLeaves ? inc->leaves[a - 1]->parent : NULL;
+    for (; candidate != NULL; candidate = candidate->parent) {
+        if (!isReparseBoundary(inc, candidate)) continue;
+        if (!isWithin(inc, inc->leaves[b], candidate)) {
+            if (isFunctionNode(inc, candidate)) break;
+            continue;
+        }
+        
+        // Token range [s, e) of the candidate; it contains a - 1 and b
+        int s = a - 1, e = b + 1;
+        while (s > 0 && isWithin(inc, inc->leaves[s - 1], candidate)) s--;
+        while (e < inc->numLeaves && isWithin(inc, inc->leaves[e], candidate)) e++;
+        
+        // The same range in tokens. The tree has no errors, so its leaves are the known
+        // tokens in order and only skipped unknown tokens lie between them.
+        int ts = first, te = first + numNew;
+        for (int k = a - s; k > 0;) {
+            if (inc->tokens[--ts].terminalIndex != -1) k--;
+        }
+        for (int k = e - b; k > 0;) {
+            if (inc->tokens[te++].terminalIndex != -1) k--;
+        }
+        
+        int numSlice = te - ts, numKnown = 0;
+        Token* slice = (Token*)malloc((numSlice + 1) * sizeof(Token));
+        memcpy(slice, inc->tokens + ts, numSlice * sizeof(Token));
+        for (int i = 0; i < numSlice; i++) {
+            if (slice[i].terminalIndex != -1) numKnown++;
+        }
+        setDollarToken(grammar, &slice[numSlice], slice[numSlice - 1].lineNumber);
+        
+        bool error;
+        ParseTreeNode* subtree = runPredictiveParserFrom(grammar, inc->parseTable, NULL, candidate->symbolIndex,
+                                                         slice, numSlice + 1, false, NULL, &error);
+        free(slice);
+        
+        // Rules chosen after the last token saw TK_DOLLAR as lookahead; in place they see
+        // the token after the subtree and must come out the same
+        ParseTreeNode** fresh = NULL;
+        int numFresh = 0, freshCapacity = 0;
+        collectTokenLeaves(subtree, &fresh, &numFresh, &freshCapacity);
+        if (!error && numFresh == numKnown) {
+            int follow = e < inc->numLeaves ? inc->leaves[e]->symbolIndex : findTerminalIndex(grammar, DOLLAR_TOKEN);
+            ParseTreeNode* lastLeaf = fresh[numFresh - 1];
+            bool afterLast = false;
+            TreeWalkStack stack = {NULL, 0, 0};
+            
+            pushTreeWalk(&stack, subtree, 0);
+            while (stack.top > 0 && !error) {
+                TreeWalkEntry entry = stack.entries[--stack.top];
+                ParseTreeNode* current = entry.node;
+                if (entry.tag && current->nextSibling != NULL) pushTreeWalk(&stack, current->nextSibling, 1);
+                if (current->firstChild != NULL) pushTreeWalk(&stack, current->firstChild, 1);
+                
+                if (current == lastLeaf) afterLast = true;
+                if (afterLast && !current->isTerminal &&
+                    getParseTableEntry(inc->parseTable, current->symbolIndex, follow) != current->ruleNumber) {
+                    error = true;
+                }
+            }
+            free(stack.entries);
+        } else {
+            error = true;
+        }
+        
+        if (error) {
+            free(fresh);
+            freeParseTree(subtree);
+            if (isFunctionNode(inc, candidate)) break;
+            continue;
+        }
+        
+        // Splice the new subtree in place of the old one
+        ParseTreeNode* parent = candidate->parent;
+        subtree->parent = parent;
+        subtree->nextSibling = candidate->nextSibling;
+        if (parent->firstChild == candidate) {
+            parent->firstChild = subtree;
+        } else {
+            ParseTreeNode* previous = parent->firstChild;
+            while (previous->nextSibling != candidate) previous = previous->nextSibling;
+            previous->nextSibling = subtree;
+        }
+        candidate->nextSibling = NULL;
+        freeParseTree(candidate);
+        
+        int numLeaves = inc->numLeaves - (e - s) + numFresh;
+        if (numLeaves > inc->capacity) {
+            inc->capacity = numLeaves * 2;
+            inc->leaves = (ParseTreeNode**)realloc(inc->leaves, inc->capacity * sizeof(ParseTreeNode*));
+        }
+        if (numFresh != e - s) {
+            memmove(inc->leaves + s + numFresh, inc->leaves + e, (inc->numLeaves - e) * sizeof(ParseTreeNode*));
+        }
+        memcpy(inc->leaves + s, fresh, numFresh * sizeof(ParseTreeNode*));
+        inc->numLeaves = numLeaves;
+        inc->reparsedTokens = numSlice;
+        free(fresh);
+        return true;
+    }
+    
+    // No enclosing subtree worked: parse all the edited tokens
+    fullReparse(inc);
+    return false;
+}
+
+// Grow the trace so at least one more step fits
+static inline void appendTraceStep(DerivationTrace* trace, uint32_t step) {
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 1024;
+        trace->steps = (uint32_t*)realloc(trace->steps, trace->capacity * sizeof(uint32_t));
+    }
+    trace->steps[trace->count++] = step;
+}
+
+// Run the LL(1) parse without building a tree, recording only the leftmost derivation.
+// Makes the same decisions and error recovery as runPredictiveParser, so replaying the
+// trace with materializeParseTree gives exactly the tree runPredictiveParser would build.
+void recordDerivation(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                      Token* tokens, int numTokens, DerivationTrace* trace) {
+    int numTerminals = grammar->numTerminals;
+    int dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    
+    // Symbols on the stack: terminal t is t, non-terminal n is numTerminals + n
+    int capacity = 256;
+    int* stack = (int*)malloc(capacity * sizeof(int));
+    int top = 0;
+    stack[top++] = dollarIndex;
+    stack[top++] = numTerminals + findNonTerminalIndex(grammar, grammar->startSymbol);
+    
+    trace->count = 0;
+    trace->error = false;
+    int currentToken = 0;
+    
+    while (top > 0) {
+        int X = stack[top - 1];
+        int a_idx = tokens[currentToken].terminalIndex;
+        
+        if (X < numTerminals) {
+            top--;
+            if (X == a_idx) {
+                appendTraceStep(trace, TRACE_TOKEN | (uint32_t)currentToken);
+                currentToken++;
+            } else {
+                trace->error = true;
+                appendTraceStep(trace, TRACE_POP);
+            }
+            continue;
+        }
+        
+        if (a_idx == -1) {
+            currentToken++;
+            continue;
+        }
+        
+        int A = X - numTerminals;
+        int rule_num = getParseTableEntry(parseTable, A, a_idx);
+        if (predictor != NULL && rule_num > 0) {
+            int decision = predictor->decisionOf[A * numTerminals + a_idx];
+            if (decision >= 0) {
+                rule_num = adaptivePredict(predictor, decision, tokens, currentToken, numTokens);
+            }
+        }
+        if (rule_num == PARSE_TABLE_ERROR && a_idx == dollarIndex) {
+            rule_num = PARSE_TABLE_SYNCH;
+        }
+        
+        if (rule_num > 0) {
+            top--;
+            appendTraceStep(trace, (uint32_t)rule_num);
+            
+            SymbolList* symbols = grammar->rules[rule_num]->symbols;
+            if (top + symbols->length > capacity) {
+                capacity = (top + symbols->length) * 2;
+                stack = (int*)realloc(stack, capacity * sizeof(int));
+            }
+            
+            // Push the RHS in reverse order, epsilon pushes nothing
+            int base = top;
+            for (Symbol* rhs = symbols->head->next; rhs != NULL; rhs = rhs->next) {
+                if (rhs->isTerminal && rhs->id.terminal == epsilonIndex) continue;
+                stack[top++] = rhs->isTerminal ? rhs->id.terminal : numTerminals + rhs->id.nonTerminal;
+            }
+            for (int i = base, j = top - 1; i < j; i++, j--) {
+                int tmp = stack[i];
+                stack[i] = stack[j];
+                stack[j] = tmp;
+            }
+        } else if (rule_num == PARSE_TABLE_SYNCH) {
+            trace->error = true;
+            top--;
+            appendTraceStep(trace, TRACE_POP);
+        } else {
+            trace->error = true;
+            currentToken++;
+        }
+    }
+    
+    if (currentToken < numTokens - 1) {
+        trace->error = true;
+    }
+    
+    free(stack);
+}
+
+// Replay a derivation trace into a ParseTreeNode tree. tokens must be the array the
+// trace was recorded from; compactTree builds the same shape as runPredictiveParser's.
+ParseTreeNode* materializeParseTree(Grammar* grammar, DerivationTrace* trace, Token* tokens, bool compactTree) {
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    ParseTreeNode* root = createNode(false, findNonTerminalIndex(grammar, grammar->startSymbol), 0, NULL);
+    
+    // Mirror of the parser stack, NULL stands for $
+    int capacity = 256;
+    ParseTreeNode** stack = (ParseTreeNode**)malloc(capacity * sizeof(ParseTreeNode*));
+    int top = 0;
+    stack[top++] = NULL;
+    stack[top++] = root;
+    
+    for (int i = 0; i < trace->count && top > 0; i++) {
+        uint32_t step = trace->steps[i];
+        ParseTreeNode* node = stack[--top];
+        
+        if (step == TRACE_POP) {
+            continue;
+        }
+        if (step & TRACE_TOKEN) {
+            if (node != NULL) {
+                Token* token = &tokens[step & ~TRACE_TOKEN];
+                snprintf(node->lexeme, sizeof(node->lexeme), "%s", token->lexeme);
+                node->lineNumber = token->lineNumber;
+            }
+            continue;
+        }
+        
+        int rule_num = (int)step;
+        SymbolList* symbols = grammar->rules[rule_num]->symbols;
+        Symbol* first = symbols->head->next;
+        node->ruleNumber = rule_num;
+        
+        // Epsilon rule: a TK_EPS leaf, or nothing at all in a compact tree
+        if (first != NULL && first->isTerminal && first->id.terminal == epsilonIndex && first->next == NULL) {
+            if (compactTree) {
+                compactParseTreeNode(node);
+            } else {
+                addChild(node, createNode(true, epsilonIndex, 0, NULL));
+            }
+            continue;
+        }
+        
+        if (top + symbols->length > capacity) {
+            capacity = (top + symbols->length) * 2;
+            stack = (ParseTreeNode**)realloc(stack, capacity * sizeof(ParseTreeNode*));
+        }
+        
+        // Link the children in order, then push them so the first one is on top
+        int base = top;
+        ParseTreeNode* last = NULL;
+        for (Symbol* rhs = first; rhs != NULL; rhs = rhs->next) {
+            ParseTreeNode* child = createNode(rhs->isTerminal,
+                                              rhs->isTerminal ? rhs->id.terminal : rhs->id.nonTerminal, 0, NULL);
+            child->parent = node;
+            if (last == NULL) {
+                node->firstChild = child;
+            } else {
+                last->nextSibling = child;
+            }
+            last = child;
+            stack[top++] = child;
+        }
+        for (int a = base, b = top - 1; a < b; a++, b--) {
+            ParseTreeNode* tmp = stack[a];
+            stack[a] = stack[b];
+            stack[b] = tmp;
+        }
+        
+        if (compactTree && top - base == 1) {
+            compactParseTreeNode(node);
+        }
+    }
+    
+    free(stack);
+    return root;
+}
+
+void freeDerivationTrace(DerivationTrace* trace) {
+    free(trace->steps);
+    trace->steps = NULL;
+    trace->count = trace->capacity = 0;
+}
+
+// LL(1) parse that reports enter/token/exit events instead of building a tree. Memory
+// use is the parser stack only. Returns true if the input had no syntax errors.
+bool parseWithCallbacks(Grammar* grammar, ParseTable* parseTable, AdaptivePredictor* predictor,
+                        Token* tokens, int numTokens, ParseCallbacks* callbacks) {
+    int numTerminals = grammar->numTerminals;
+    int dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    void* userData = callbacks->userData;
+    char message[200];
+    
+    // Terminal t is t, non-terminal n is numTerminals + n, and -r marks the end of rule r
+    int capacity = 256;
+    int* stack = (int*)malloc(capacity * sizeof(int));
+    int top = 0;
+    stack[top++] = dollarIndex;
+    stack[top++] = numTerminals + findNonTerminalIndex(grammar, grammar->startSymbol);
+    
+    bool error = false;
+    int currentToken = 0;
+    
+    while (top > 0) {
+        int X = stack[top - 1];
+        Token* token = &tokens[currentToken];
+        int a_idx = token->terminalIndex;
+        
+        if (X < 0) {
+            top--;
+            if (callbacks->exitNonTerminal) callbacks->exitNonTerminal(userData, -X);
+            continue;
+        }
+        
+        if (X < numTerminals) {
+            top--;
+            if (X == a_idx) {
+                if (callbacks->token) callbacks->token(userData, X, token->lexeme, token->lineNumber);
+                currentToken++;
+            } else {
+                error = true;
+                if (callbacks->syntaxError) {
+                    snprintf(message, sizeof(message), "Expected %s", grammar->terminals[X]);
+                    callbacks->syntaxError(userData, token->lineNumber, token->token, message);
+                }
+            }
+            continue;
+        }
+        
+        // Unknown tokens are skipped silently, as in runPredictiveParser
+        int A = X - numTerminals;
+        if (a_idx == -1) {
+            currentToken++;
+            continue;
+        }
+        
+        int rule_num = getParseTableEntry(parseTable, A, a_idx);
+        if (predictor != NULL && rule_num > 0) {
+            int decision = predictor->decisionOf[A * numTerminals + a_idx];
+            if (decision >= 0) {
+                rule_num = adaptivePredict(predictor, decision, tokens, currentToken, numTokens);
+            }
+        }
+        if (rule_num == PARSE_TABLE_ERROR && a_idx == dollarIndex) {
+            rule_num = PARSE_TABLE_SYNCH;
+        }
+        
+        if (rule_num > 0) {
+            top--;
+            if (callbacks->enterNonTerminal) callbacks->enterNonTerminal(userData, rule_num, token->lineNumber);
+            
+            SymbolList* symbols = grammar->rules[rule_num]->symbols;
+            if (top + symbols->length + 1 > capacity) {
+                capacity = (top + symbols->length + 1) * 2;
+                stack = (int*)realloc(stack, capacity * sizeof(int));
+            }
+            
+            // The end marker goes below the RHS, pushed in reverse order
+            stack[top++] = -rule_num;
+            int base = top;
+            for (Symbol* rhs = symbols->head->next; rhs != NULL; rhs = rhs->next) {
+                if (rhs->isTerminal && rhs->id.terminal == epsilonIndex) continue;
+                stack[top++] = rhs->isTerminal ? rhs->id.terminal : numTerminals + rhs->id.nonTerminal;
+            }
+            for (int i = base, j = top - 1; i < j; i++, j--) {
+                int tmp = stack[i];
+                stack[i] = stack[j];
+                stack[j] = tmp;
+            }
+        } else if (rule_num == PARSE_TABLE_SYNCH) {
+            error = true;
+            top--;
+            if (callbacks->syntaxError) {
+                snprintf(message, sizeof(message), "Missing %s", grammar->nonTerminals[A]);
+                callbacks->syntaxError(userData, token->lineNumber, token->token, message);
+            }
+        } else {
+            error = true;
+            if (callbacks->syntaxError) {
+                snprintf(message, sizeof(message), "No rule for %s, skipping token", grammar->nonTerminals[A]);
+                callbacks->syntaxError(userData, token->lineNumber, token->token, message);
+            }
+            currentToken++;
+        }
+    }
+    
+    if (currentToken < numTokens - 1) {
+        error = true;
+        if (callbacks->syntaxError) {
+            callbacks->syntaxError(userData, tokens[currentToken].lineNumber, tokens[currentToken].token,
+                                   "Extra tokens in input");
+        }
+    }
+    
+    free(stack);
+    return !error;
+}
+
+// JSON string with the escaping RFC 8259 requires; runs of plain bytes are copied at once
+static void writeJsonString(TreeWriter* writer, const char* text) {
+    static const char hex[] = "0123456789abcdef";
+    const char* run = text;
+    
+    WRITE_LITERAL(writer, "\"");
+    for (const char* p = text; ; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        
+        writeBytes(writer, run, (size_t)(p - run));
+        if (c == '\0') break;
+        run = p + 1;
+        
+        char escape[6] = {'\\', (char)c, 0, 0, 0, 0};
+        size_t length = 2;
+        switch (c) {
+            case '"': case '\\': break;
+            case '\n': escape[1] = 'n'; break;
+            case '\t': escape[1] = 't'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = hex[c >> 4];
+                escape[5] = hex[c & 15];
+                length = 6;
+        }
+        writeBytes(writer, escape, length);
+    }
+    WRITE_LITERAL(writer, "\"");
+}
+
+// {"symbol":"TK_ID","line":6,"lexeme":"b5"}
+static inline void writeJsonLeaf(TreeWriter* writer, Grammar* grammar, int terminal, int line, const char* lexeme) {
+    WRITE_LITERAL(writer, "{\"symbol\":");
+    writeJsonString(writer, grammar->terminals[terminal]);
+    WRITE_LITERAL(writer, ",\"line\":");
+    writePaddedInt(writer, line, 0);
+    WRITE_LITERAL(writer, ",\"lexeme\":");
+    writeJsonString(writer, lexeme);
+    WRITE_LITERAL(writer, "}");
+}
+
+// {"symbol":"stmt","rule":36,"children":[ ... closed by writeJsonClose
+static inline void writeJsonOpen(TreeWriter* writer, Grammar* grammar, int nonTerminal, int rule) {
+    WRITE_LITERAL(writer, "{\"symbol\":");
+    writeJsonString(writer, grammar->nonTerminals[nonTerminal]);
+    if (rule >= 0) {
+        WRITE_LITERAL(writer, ",\"rule\":");
+        writePaddedInt(writer, rule, 0);
+    }
+    WRITE_LITERAL(writer, ",\"children\":[");
+}
+
+static inline void writeJsonClose(TreeWriter* writer) {
+    WRITE_LITERAL(writer, "]}");
+}
+
+// Top-level functions are the documents of the newline-delimited output
+static inline bool isJsonDocumentRoot(Grammar* grammar, int nonTerminal) {
+    return strcmp(grammar->nonTerminals[nonTerminal], "function") == 0 ||
+           strcmp(grammar->nonTerminals[nonTerminal], "mainFunction") == 0;
+}
+
+#define JSON_FIRST 0   // first child: no comma, later siblings follow
+#define JSON_NEXT 1    // later child: comma, later siblings follow
+#define JSON_ROOT 2    // document root: neither
+#define JSON_CLOSE 3
+
+// Write the subtree under node as one JSON value. Terminals without a lexeme (epsilon,
+// and terminals error recovery inserted) are left out, like in the inorder traversal.
+static void writeJsonSubtree(TreeWriter* writer, Grammar* grammar, ParseTreeNode* node, TreeWalkStack* stack) {
+    pushTreeWalk(stack, node, JSON_ROOT);
+    bool needComma = false;
+    
+    while (stack->top > 0) {
+        TreeWalkEntry entry = stack->entries[--stack->top];
+        ParseTreeNode* current = entry.node;
+        
+        if (entry.tag == JSON_CLOSE) {
+            writeJsonClose(writer);
+            needComma = true;
+            continue;
+        }
+        if (entry.tag == JSON_FIRST) needComma = false;
+        if (entry.tag != JSON_ROOT && current->nextSibling != NULL) {
+            pushTreeWalk(stack, current->nextSibling, JSON_NEXT);
+        }
+        
+        if (current->isTerminal) {
+            if (current->lexeme[0] == '\0') continue;
+            if (needComma) WRITE_LITERAL(writer, ",");
+            writeJsonLeaf(writer, grammar, current->symbolIndex, current->lineNumber, current->lexeme);
+            needComma = true;
+        } else {
+            if (needComma) WRITE_LITERAL(writer, ",");
+            writeJsonOpen(writer, grammar, current->symbolIndex, current->ruleNumber);
+            pushTreeWalk(stack, current, JSON_CLOSE);
+            needComma = false;
+            if (current->firstChild != NULL) pushTreeWalk(stack, current->firstChild, JSON_FIRST);
+        }
+    }
+}
+
+// Write the parse tree as a single JSON document, or with ndjson as one line per
+// top-level function (function and mainFunction subtrees)
+void writeParseTreeJson(ParseTreeNode* root, Grammar* grammar, bool ndjson, FILE* outFile) {
+    if (root == NULL) return;
+    
+    TreeWriter* writer = openTreeWriter(outFile);
+    TreeWalkStack stack = {NULL, 0, 0};
+    
+    if (!ndjson) {
+        writeJsonSubtree(writer, grammar, root, &stack);
+        WRITE_LITERAL(writer, "\n");
+    } else {
+        // Preorder search for document roots; the tag says whether to follow siblings
+        TreeWalkStack search = {NULL, 0, 0};
+        pushTreeWalk(&search, root, 0);
+        while (search.top > 0) {
+            TreeWalkEntry entry = search.entries[--search.top];
+            ParseTreeNode* current = entry.node;
+            
+            if (entry.tag && current->nextSibling != NULL) pushTreeWalk(&search, current->nextSibling, 1);
+            if (current->isTerminal) continue;
+            
+            if (isJsonDocumentRoot(grammar, current->symbolIndex)) {
+                writeJsonSubtree(writer, grammar, current, &stack);
+                WRITE_LITERAL(writer, "\n");
+            } else if (current->firstChild != NULL) {
+                pushTreeWalk(&search, current->firstChild, 1);
+            }
+        }
+        free(search.entries);
+    }
+    
+    free(stack.entries);
+    closeTreeWriter(writer);
+}
+
+// Event consumer that writes the same JSON as writeParseTreeJson while parseWithCallbacks
+// runs, without building a tree. Output matches writeParseTreeJson for inputs without
+// syntax errors.
+typedef struct {
+    Grammar* grammar;
+    TreeWriter* writer;
+    bool ndjson;
+    bool needComma;
+    int depth;           // open non-terminals
+    int documentDepth;   // depth of the current document root, -1 outside a document
+    int documents;       // documents opened so far
+    int dollarIndex;
+} JsonEmitter;
+
+static void jsonEnter(void* userData, int rule, int line) {
+    JsonEmitter* emitter = (JsonEmitter*)userData;
+    int nonTerminal = emitter->grammar->rules[rule]->symbols->head->id.nonTerminal;
+    (void)line;
+    
+    emitter->depth++;
+    if (emitter->documentDepth < 0) {
+        if (emitter->ndjson && !isJsonDocumentRoot(emitter->grammar, nonTerminal)) return;
+        emitter->documentDepth = emitter->depth;
+        emitter->documents++;
+    } else if (emitter->needComma) {
+        WRITE_LITERAL(emitter->writer, ",");
+    }
+    writeJsonOpen(emitter->writer, emitter->grammar, nonTerminal, rule);
+    emitter->needComma = false;
+}
+
+static void jsonToken(void* userData, int terminal, const char* lexeme, int line) {
+    JsonEmitter* emitter = (JsonEmitter*)userData;
+    if (emitter->documentDepth < 0 || terminal == emitter->dollarIndex) return;
+    
+    if (emitter->needComma) WRITE_LITERAL(emitter->writer, ",");
+    writeJsonLeaf(emitter->writer, emitter->grammar, terminal, line, lexeme);
+    emitter->needComma = true;
+}
+
+static void jsonExit(void* userData, int rule) {
+    JsonEmitter* emitter = (JsonEmitter*)userData;
+    (void)rule;
+    
+    if (emitter->documentDepth >= 0) {
+        writeJsonClose(emitter->writer);
+        emitter->needComma = true;
+        if (emitter->depth == emitter->documentDepth) {
+            WRITE_LITERAL(emitter->writer, "\n");
+            emitter->documentDepth = -1;
+        }
+    }
+    emitter->depth--;
+}
+
+// Parse and write JSON in one pass. Returns true if the input had no syntax errors.
+bool parseToJson(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                 bool ndjson, FILE* outFile) {
+    JsonEmitter emitter = {grammar, openTreeWriter(outFile), ndjson, false, 0, -1, 0,
+                           findTerminalIndex(grammar, DOLLAR_TOKEN)};
+    ParseCallbacks callbacks = {jsonEnter, jsonToken, jsonExit, NULL, &emitter};
+    
+    bool ok = parseWithCallbacks(grammar, parseTable, NULL, tokens, numTokens, &callbacks);
+    
+    // A syntax error can stop the parse inside a document, or before the start symbol
+    // was expanded; close what is open so the output stays valid JSON
+    while (emitter.documentDepth >= 0) jsonExit(&emitter, -1);
+    if (!ndjson && emitter.documents == 0) {
+        writeJsonOpen(emitter.writer, grammar, findNonTerminalIndex(grammar, grammar->startSymbol), -1);
+        writeJsonClose(emitter.writer);
+        WRITE_LITERAL(emitter.writer, "\n");
+    }
+    closeTreeWriter(emitter.writer);
+    return ok;
+}
+
+static void advanceTokenStream(TokenStream* stream) {
+    char line[1024];
+    
+    while (!stream->atEnd && fgets(line, sizeof(line), stream->file)) {
+        if (parseTokenLine(line, &stream->current)) {
+            stream->current.terminalIndex = findTerminalIndex(stream->grammar, stream->current.token);
+            stream->tokensRead++;
+            return;
+        }
+    }
+    
+    // Same end marker readTokensFromFile appends, on the line of the last token
+    stream->atEnd = true;
+    strcpy(stream->current.lexeme, "$");
+    strcpy(stream->current.token, DOLLAR_TOKEN);
+    stream->current.terminalIndex = findTerminalIndex(stream->grammar, DOLLAR_TOKEN);
+}
+
+// One entry of the streaming parser stack. emitAfter is the non-terminal whose line of the
+// inorder traversal comes right after this symbol's subtree (set for first children only),
+// -1 if none. END entries mark where an expanded non-terminal's subtree ends.
+#define STREAM_END -1
+
+typedef struct {
+    int symbol;      // terminal t, non-terminal numTerminals + n, or STREAM_END
+    int emitAfter;
+} StreamEntry;
+
+static void writeInternalNodeLine(Grammar* grammar, int nonTerminal, FILE* outFile) {
+    fprintf(outFile, "%-20s", grammar->nonTerminals[nonTerminal]);
+    fprintf(outFile, "Line: ---");
+    fprintf(outFile, "   Internal Node\n");
+}
+
+// Streaming LL(1) parse for inputs too large to hold in memory. Tokens are read one at a
+// time and each line of the inorder traversal is written as soon as the subtree before it
+// is complete, so no tree is kept at all: memory is the parser stack, bounded by nesting
+// depth. parseTreeFile gets the same content parseTokens writes.
+bool streamParseTokens(Grammar* grammar, ParseTable* parseTable, const char* tokenFile,
+                       const char* parseTreeFile, int* peakStackDepth) {
+    TokenStream stream = {NULL, grammar, {{0}, {0}, 1, -1}, false, 0};
+    stream.file = fopen(tokenFile, "r");
+    if (!stream.file) {
+        printf("Error opening token file: %s\n", tokenFile);
+        return false;
+    }
+    
+    FILE* outFile = fopen(parseTreeFile, "w");
+    if (!outFile) {
+        printf("Error opening parse tree file\n");
+        fclose(stream.file);
+        return false;
+    }
+    fprintf(outFile, "Parse Tree Inorder Traversal:\n");
+    fprintf(outFile, "============================\n\n");
+    fprintf(outFile, "%-20s%-15s%-20s\n", "Token/Non-Terminal", "Line Number", "Lexeme/Type");
+    fprintf(outFile, "------------------------------------------------------------\n");
+    
+    int numTerminals = grammar->numTerminals;
+    int dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    
+    int capacity = 256;
+    StreamEntry* stack = (StreamEntry*)malloc(capacity * sizeof(StreamEntry));
+    int top = 0;
+    int peak = 0;
+    stack[top].symbol = dollarIndex;
+    stack[top++].emitAfter = -1;
+    stack[top].symbol = numTerminals + findNonTerminalIndex(grammar, grammar->startSymbol);
+    stack[top++].emitAfter = -1;
+    
+    bool error = false;
+    bool dollarMatched = false;
+    advanceTokenStream(&stream);
+    
+    while (top > 0) {
+        if (top > peak) peak = top;
+        StreamEntry X = stack[top - 1];
+        Token* token = &stream.current;
+        int a_idx = token->terminalIndex;
+        
+        if (X.symbol == STREAM_END) {
+            top--;
+            if (X.emitAfter >= 0) writeInternalNodeLine(grammar, X.emitAfter, outFile);
+            continue;
+        }
+        
+        if (X.symbol < numTerminals) {
+            top--;
+            if (X.symbol == a_idx) {
+                // The bottom $ has no tree node and is never written
+                if (X.symbol == dollarIndex && top == 0) {
+                    dollarMatched = true;
+                } else {
+                    fprintf(outFile, "%-20s", grammar->terminals[X.symbol]);
+                    fprintf(outFile, "Line: %-4d", token->lineNumber);
+                    fprintf(outFile, "Lexeme: %-20s\n", token->lexeme);
+                }
+                if (!stream.atEnd) advanceTokenStream(&stream);
+            } else {
+                error = true;
+            }
+            if (X.emitAfter >= 0) writeInternalNodeLine(grammar, X.emitAfter, outFile);
+            continue;
+        }
+        
+        // Unknown tokens are skipped silently, as in runPredictiveParser
+        int A = X.symbol - numTerminals;
+        if (a_idx == -1) {
+            advanceTokenStream(&stream);
+            continue;
+        }
+        
+        int rule_num = getParseTableEntry(parseTable, A, a_idx);
+        if (rule_num == PARSE_TABLE_ERROR && a_idx == dollarIndex) {
+            rule_num = PARSE_TABLE_SYNCH;
+        }
+        
+        if (rule_num > 0) {
+            top--;
+            SymbolList* symbols = grammar->rules[rule_num]->symbols;
+            Symbol* first = symbols->head->next;
+            
+            // Epsilon: the TK_EPS leaf prints nothing, so the non-terminal's own line follows at once
+            if (first != NULL && first->isTerminal && first->id.terminal == epsilonIndex) {
+                writeInternalNodeLine(grammar, A, outFile);
+                if (X.emitAfter >= 0) writeInternalNodeLine(grammar, X.emitAfter, outFile);
+                continue;
+            }
+            
+            if (top + symbols->length + 1 > capacity) {
+                capacity = (top + symbols->length + 1) * 2;
+                stack = (StreamEntry*)realloc(stack, capacity * sizeof(StreamEntry));
+            }
+            
+            if (X.emitAfter >= 0) {
+                stack[top].symbol = STREAM_END;
+                stack[top++].emitAfter = X.emitAfter;
+            }
+            
+            // Push the RHS in reverse order; A's line follows its first child
+            int base = top;
+            for (Symbol* rhs = first; rhs != NULL; rhs = rhs->next) {
+                stack[top].symbol = rhs->isTerminal ? rhs->id.terminal : numTerminals + rhs->id.nonTerminal;
+                stack[top++].emitAfter = (rhs == first) ? A : -1;
+            }
+            for (int i = base, j = top - 1; i < j; i++, j--) {
+                StreamEntry tmp = stack[i];
+                stack[i] = stack[j];
+                stack[j] = tmp;
+            }
+        } else if (rule_num == PARSE_TABLE_SYNCH) {
+            // The popped non-terminal stays a childless internal node
+            error = true;
+            top--;
+            writeInternalNodeLine(grammar, A, outFile);
+            if (X.emitAfter >= 0) writeInternalNodeLine(grammar, X.emitAfter, outFile);
+        } else {
+            error = true;
+            advanceTokenStream(&stream);
+        }
+    }
+    
+    if (!dollarMatched) {
+        error = true;
+    }
+    
+    if (peakStackDepth) *peakStackDepth = peak;
+    free(stack);
+    fclose(outFile);
+    fclose(stream.file);
+    return !error;
+}
+
+// One unit of work for the parallel parser: a slice of the token array derived from a
+// single non-terminal (a function, or the main function)
+typedef struct {
+    int start;           // first token of the slice
+    int end;             // one past the last token
+    int symbol;          // non-terminal the slice derives
+    ParseTreeNode* tree;
+    bool error;
+} FunctionParseJob;
+
+typedef struct {
+    Grammar* grammar;
+    ParseTable* parseTable;
+    Token* tokens;
+    int numTokens;
+    FunctionParseJob* jobs;
+    int* order;          // jobs sorted by size, largest first
+    int numJobs;
+    int nextJob;
+    pthread_mutex_t lock;
+} ParallelParse;
+
+// Split the tokens into top-level functions. A function starts at a TK_FUNID outside any
+// function and ends at its TK_END (only functions and main use TK_END), and the main
+// function runs from TK_MAIN to the end. Returns the number of functions, or -1 if the
+// tokens do not have that shape.
+int findFunctionBoundaries(Grammar* grammar, Token* tokens, int numTokens, int* starts, int* ends, int* mainStart) {
+    int funIndex = findTerminalIndex(grammar, "TK_FUNID");
+    int endIndex = findTerminalIndex(grammar, "TK_END");
+    int mainIndex = findTerminalIndex(grammar, "TK_MAIN");
+    int count = 0;
+    bool inFunction = false;
+    
+    for (int i = 0; i < numTokens; i++) {
+        int t = tokens[i].terminalIndex;
+        if (inFunction) {
+            if (t == endIndex) {
+                ends[count++] = i + 1;
+                inFunction = false;
+            }
+        } else if (t == funIndex) {
+            starts[count] = i;
+            inFunction = true;
+        } else if (t == mainIndex) {
+            *mainStart = i;
+            return count;
+        } else {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+static void* functionParseWorker(void* arg) {
+    ParallelParse* work = (ParallelParse*)arg;
+    
+    for (;;) {
+        pthread_mutex_lock(&work->lock);
+        int next = work->nextJob++;
+        pthread_mutex_unlock(&work->lock);
+        if (next >= work->numJobs) break;
+        
+        FunctionParseJob* job = &work->jobs[work->order[next]];
+        int length = job->end - job->start;
+        bool endsWithDollar = job->end == work->numTokens;
+        
+        // The slice gets its own TK_DOLLAR so the parser knows where to stop
+        Token* slice = (Token*)malloc((length + 1) * sizeof(Token));
+        memcpy(slice, work->tokens + job->start, length * sizeof(Token));
+        if (!endsWithDollar) {
+            slice[length] = work->tokens[work->numTokens - 1];
+            length++;
+        }
+        
+        job->tree = runPredictiveParserFrom(work->grammar, work->parseTable, NULL, job->symbol,
+                                            slice, length, false, NULL, &job->error);
+        free(slice);
+    }
+    return NULL;
+}
+
+// Parse each function on a pool of threads and stitch the subtrees into the
+// program -> otherFunctions mainFunction skeleton. The result is the tree
+// runPredictiveParser builds. Inputs with syntax errors, or grammars without that
+// skeleton, are parsed sequentially so error recovery stays the same.
+ParseTreeNode* parseFunctionsInParallel(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                                        int numThreads, bool* hadError) {
+    int programIndex = findNonTerminalIndex(grammar, grammar->startSymbol);
+    int otherFunctionsIndex = findNonTerminalIndex(grammar, "otherFunctions");
+    int functionIndex = findNonTerminalIndex(grammar, "function");
+    int mainFunctionIndex = findNonTerminalIndex(grammar, "mainFunction");
+    int funIndex = findTerminalIndex(grammar, "TK_FUNID");
+    int mainIndex = findTerminalIndex(grammar, "TK_MAIN");
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    
+    int* starts = (int*)malloc(numTokens * sizeof(int));
+    int* ends = (int*)malloc(numTokens * sizeof(int));
+    int mainStart = -1;
+    int numFunctions = -1;
+    
+    // The rules that build the skeleton, as the table would pick them. A first token the
+    // grammar does not know has no table column, so it takes the sequential path.
+    int programRule = -1, moreRule = -1, doneRule = -1;
+    if (programIndex >= 0 && otherFunctionsIndex >= 0 && functionIndex >= 0 && mainFunctionIndex >= 0 &&
+        funIndex >= 0 && mainIndex >= 0 && numTokens > 0 && tokens[0].terminalIndex >= 0) {
+        programRule = getParseTableEntry(parseTable, programIndex, tokens[0].terminalIndex);
+        moreRule = getParseTableEntry(parseTable, otherFunctionsIndex, funIndex);
+        doneRule = getParseTableEntry(parseTable, otherFunctionsIndex, mainIndex);
+        numFunctions = findFunctionBoundaries(grammar, tokens, numTokens, starts, ends, &mainStart);
+    }
+    
+    bool skeleton = numFunctions >= 0 && programRule > 0 && moreRule > 0 && doneRule > 0;
+    if (skeleton) {
+        Symbol* rhs = grammar->rules[programRule]->symbols->head->next;
+        skeleton = rhs != NULL && !rhs->isTerminal && rhs->id.nonTerminal == otherFunctionsIndex &&
+                   rhs->next != NULL && !rhs->next->isTerminal && rhs->next->id.nonTerminal == mainFunctionIndex &&
+                   rhs->next->next == NULL;
+        rhs = grammar->rules[moreRule]->symbols->head->next;
+        skeleton = skeleton && rhs != NULL && !rhs->isTerminal && rhs->id.nonTerminal == functionIndex &&
+                   rhs->next != NULL && !rhs->next->isTerminal && rhs->next->id.nonTerminal == otherFunctionsIndex &&
+                   rhs->next->next == NULL;
+        rhs = grammar->rules[doneRule]->symbols->head->next;
+        skeleton = skeleton && rhs != NULL && rhs->isTerminal && rhs->id.terminal == epsilonIndex;
+    }
+    if (!skeleton) {
+        free(starts);
+        free(ends);
+        return runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, hadError);
+    }
+    
+    // One job per function plus one for the main function
+    ParallelParse work;
+    work.grammar = grammar;
+    work.parseTable = parseTable;
+    work.tokens = tokens;
+    work.numTokens = numTokens;
+    work.numJobs = numFunctions + 1;
+    work.nextJob = 0;
+    work.jobs = (FunctionParseJob*)malloc(work.numJobs * sizeof(FunctionParseJob));
+    work.order = (int*)malloc(work.numJobs * sizeof(int));
+    pthread_mutex_init(&work.lock, NULL);
+    
+    for (int i = 0; i < numFunctions; i++) {
+        work.jobs[i].start = starts[i];
+        work.jobs[i].end = ends[i];
+        work.jobs[i].symbol = functionIndex;
+    }
+    work.jobs[numFunctions].start = mainStart;
+    work.jobs[numFunctions].end = numTokens;
+    work.jobs[numFunctions].symbol = mainFunctionIndex;
+    free(starts);
+    free(ends);
+    
+    // Largest jobs first keeps the threads evenly loaded
+    for (int i = 0; i < work.numJobs; i++) {
+        int size = work.jobs[i].end - work.jobs[i].start;
+        int j = i;
+        while (j > 0 && work.jobs[work.order[j - 1]].end - work.jobs[work.order[j - 1]].start < size) {
+            work.order[j] = work.order[j - 1];
+            j--;
+        }
+        work.order[j] = i;
+    }
+    
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > work.numJobs) numThreads = work.numJobs;
+    pthread_t* threads = (pthread_t*)malloc(numThreads * sizeof(pthread_t));
+    for (int i = 1; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, functionParseWorker, &work);
+    }
+    functionParseWorker(&work);
+    for (int i = 1; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    pthread_mutex_destroy(&work.lock);
+    
+    bool error = false;
+    for (int i = 0; i < work.numJobs; i++) {
+        error = error || work.jobs[i].error;
+    }
+    
+    if (error) {
+        for (int i = 0; i < work.numJobs; i++) {
+            freeParseTree(work.jobs[i].tree);
+        }
+        free(work.jobs);
+        free(work.order);
+        return runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, hadError);
+    }
+    
+    // program -> otherFunctions mainFunction, otherFunctions -> function otherFunctions | TK_EPS
+    ParseTreeNode* root = createNode(false, programIndex, 0, NULL);
+    root->ruleNumber = programRule;
+    ParseTreeNode* list = createNode(false, otherFunctionsIndex, 0, NULL);
+    addChild(root, list);
+    
+    for (int i = 0; i < numFunctions; i++) {
+        ParseTreeNode* rest = createNode(false, otherFunctionsIndex, 0, NULL);
+        list->ruleNumber = moreRule;
+        addChild(list, work.jobs[i].tree);
+        addChild(list, rest);
+        list = rest;
+    }
+    list->ruleNumber = doneRule;
+    addChild(list, createNode(true, epsilonIndex, 0, NULL));
+    addChild(root, work.jobs[numFunctions].tree);
+    
+    free(work.jobs);
+    free(work.order);
+    if (hadError) *hadError = false;
+    return root;
+}
+
+// Working data for the LALR(1) construction. Grammar symbols are numbered with the
+// terminals first followed by the non-terminals, and an item is a rule plus a dot
+// position, numbered consecutively rule by rule.
+typedef struct {
+    int numTerminals;
+    int numSymbols;
+    int numItems;
+    int words;              // uint64_t words per lookahead set
+    int** rhs;              // RHS symbols of each rule with epsilon removed
+    int** rulesOf;          // rules of each non-terminal
+    int* numRulesOf;
+    int* itemBase;          // first item of each rule
+    int* itemRule;
+    int* itemNext;          // symbol after the dot, -1 when the dot is at the end
+    uint64_t* firstAfter;   // FIRST of whatever follows the symbol after the dot
+    bool* nullableAfter;
+    
+    // LR(0) automaton
+    int numStates;
+    int capacity;
+    int** kernel;
+    int* kernelSize;
+    int** gotoOn;           // target state for each symbol, -1 if none
+    uint64_t** lookahead;   // lookahead set of each kernel item
+    
+    // Closure scratch space
+    int* closure;
+    int closureSize;
+    int* inClosure;
+    int stamp;
+    uint64_t* closureLA;
+} LALRBuilder;
+
+static inline bool lookaheadUnion(uint64_t* dst, const uint64_t* src, int words) {
+    bool changed = false;
+    for (int i = 0; i < words; i++) {
+        uint64_t merged = dst[i] | src[i];
+        if (merged != dst[i]) {
+            dst[i] = merged;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+static void lalrAddToClosure(LALRBuilder* b, int item, bool withLookaheads) {
+    if (b->inClosure[item] == b->stamp) return;
+    b->inClosure[item] = b->stamp;
+    b->closure[b->closureSize++] = item;
+    if (withLookaheads) {
+        memset(b->closureLA + (size_t)item * b->words, 0, b->words * sizeof(uint64_t));
+    }
+}
+
+// Closure of a state's kernel, optionally carrying LR(1) lookaheads along
+static void lalrClosure(LALRBuilder* b, int state, bool withLookaheads) {
+    b->stamp++;
+    b->closureSize = 0;
+    
+    for (int k = 0; k < b->kernelSize[state]; k++) {
+        int item = b->kernel[state][k];
+        lalrAddToClosure(b, item, withLookaheads);
+        if (withLookaheads) {
+            memcpy(b->closureLA + (size_t)item * b->words, b->lookahead[state] + (size_t)k * b->words,
+                   b->words * sizeof(uint64_t));
+        }
+    }
+    
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < b->closureSize; i++) {
+            int item = b->closure[i];
+            int X = b->itemNext[item];
+            if (X < b->numTerminals) continue;
+            
+            int B = X - b->numTerminals;
+            for (int k = 0; k < b->numRulesOf[B]; k++) {
+                int first = b->itemBase[b->rulesOf[B][k]];
+                lalrAddToClosure(b, first, withLookaheads);
+                if (!withLookaheads) continue;
+                
+                uint64_t* target = b->closureLA + (size_t)first * b->words;
+                if (lookaheadUnion(target, b->firstAfter + (size_t)item * b->words, b->words)) changed = true;
+                if (b->nullableAfter[item] &&
+                    lookaheadUnion(target, b->closureLA + (size_t)item * b->words, b->words)) changed = true;
+            }
+        }
+    }
+}
+
+// Find the state with the given (sorted) kernel, adding it if it does not exist yet
+static int lalrFindOrAddState(LALRBuilder* b, int* items, int count) {
+    for (int s = 0; s < b->numStates; s++) {
+        if (b->kernelSize[s] == count && memcmp(b->kernel[s], items, count * sizeof(int)) == 0) {
+            return s;
+        }
+    }
+    
+    if (b->numStates == b->capacity) {
+        b->capacity *= 2;
+        b->kernel = (int**)realloc(b->kernel, b->capacity * sizeof(int*));
+        b->kernelSize = (int*)realloc(b->kernelSize, b->capacity * sizeof(int));
+        b->gotoOn = (int**)realloc(b->gotoOn, b->capacity * sizeof(int*));
+        b->lookahead = (uint64_t**)realloc(b->lookahead, b->capacity * sizeof(uint64_t*));
+    }
+    
+    int s = b->numStates++;
+    b->kernel[s] = (int*)malloc(count * sizeof(int));
+    memcpy(b->kernel[s], items, count * sizeof(int));
+    b->kernelSize[s] = count;
+    b->gotoOn[s] = (int*)malloc(b->numSymbols * sizeof(int));
+    for (int X = 0; X < b->numSymbols; X++) b->gotoOn[s][X] = -1;
+    b->lookahead[s] = (uint64_t*)calloc((size_t)count * b->words, sizeof(uint64_t));
+    return s;
+}
+
+// Build LALR(1) action and goto tables for a grammar in the grammar.txt rule format.
+// LR(0) states are built first, then lookaheads are propagated between kernels until
+// nothing changes. Shift/reduce conflicts resolve to shift, reduce/reduce conflicts to
+// the earlier rule, and both are counted in the result.
+LALRTable* createLALRTable(Grammar* grammar) {
+    int T = grammar->numTerminals;
+    int N = grammar->numNonTerminals;
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    int dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    int startIndex = findNonTerminalIndex(grammar, grammar->startSymbol);
+    
+    if (grammar->numRules > INT16_MAX - 3) {
+        printf("Error: grammar has %d rules, LALR tables support at most %d\n", grammar->numRules, INT16_MAX - 3);
+        exit(1);
+    }
+    
+    LALRTable* lalr = (LALRTable*)malloc(sizeof(LALRTable));
+    lalr->grammar = grammar;
+    lalr->ruleLength = (int*)malloc((grammar->numRules + 1) * sizeof(int));
+    lalr->ruleLhs = (int*)malloc((grammar->numRules + 1) * sizeof(int));
+    lalr->shiftReduceConflicts = 0;
+    lalr->reduceReduceConflicts = 0;
+    
+    LALRBuilder builder;
+    LALRBuilder* b = &builder;
+    b->numTerminals = T;
+    b->numSymbols = T + N;
+    b->words = LA_WORDS(T);
+    
+    // Rule 0 is the augmented rule S' -> S
+    b->rhs = (int**)malloc((grammar->numRules + 1) * sizeof(int*));
+    b->rhs[0] = (int*)malloc(sizeof(int));
+    b->rhs[0][0] = T + startIndex;
+    lalr->ruleLength[0] = 1;
+    lalr->ruleLhs[0] = -1;
+    
+    b->numRulesOf = (int*)calloc(N, sizeof(int));
+    for (int r = 1; r <= grammar->numRules; r++) {
+        Symbol* lhs = grammar->rules[r]->symbols->head;
+        lalr->ruleLhs[r] = lhs->id.nonTerminal;
+        b->numRulesOf[lhs->id.nonTerminal]++;
+        
+        b->rhs[r] = (int*)malloc(grammar->rules[r]->symbols->length * sizeof(int));
+        int length = 0;
+        for (Symbol* sym = lhs->next; sym != NULL; sym = sym->next) {
+            if (sym->isTerminal && sym->id.terminal == epsilonIndex) continue;
+            b->rhs[r][length++] = sym->isTerminal ? sym->id.terminal : T + sym->id.nonTerminal;
+        }
+        lalr->ruleLength[r] = length;
+    }
+    
+    b->rulesOf = (int**)malloc(N * sizeof(int*));
+    for (int A = 0; A < N; A++) {
+        b->rulesOf[A] = (int*)malloc((b->numRulesOf[A] + 1) * sizeof(int));
+        b->numRulesOf[A] = 0;
+    }
+    for (int r = 1; r <= grammar->numRules; r++) {
+        int A = lalr->ruleLhs[r];
+        b->rulesOf[A][b->numRulesOf[A]++] = r;
+    }
+    
+    // FIRST sets and nullability of the non-terminals, computed to a fixpoint
+    // since the grammar may be left recursive
+    uint64_t* firstNT = (uint64_t*)calloc((size_t)N * b->words, sizeof(uint64_t));
+    bool* nullable = (bool*)calloc(N, sizeof(bool));
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int r = 1; r <= grammar->numRules; r++) {
+            int A = lalr->ruleLhs[r];
+            bool allNullable = true;
+            for (int k = 0; k < lalr->ruleLength[r] && allNullable; k++) {
+                int X = b->rhs[r][k];
+                if (X < T) {
+                    uint64_t bit = 1ULL << (X % 64);
+                    if (!(firstNT[(size_t)A * b->words + X / 64] & bit)) {
+                        firstNT[(size_t)A * b->words + X / 64] |= bit;
+                        changed = true;
+                    }
+                    allNullable = false;
+                } else {
+                    if (lookaheadUnion(firstNT + (size_t)A * b->words, firstNT + (size_t)(X - T) * b->words, b->words)) {
+                        changed = true;
+                    }
+                    allNullable = nullable[X - T];
+                }
+            }
+            if (allNullable && !nullable[A]) {
+                nullable[A] = true;
+                changed = true;
+            }
+        }
+    }
+    
+    // Number the items and precompute what follows the symbol after each dot
+    b->itemBase = (int*)malloc((grammar->numRules + 1) * sizeof(int));
+    b->numItems = 0;
+    for (int r = 0; r <= grammar->numRules; r++) {
+        b->itemBase[r] = b->numItems;
+        b->numItems += lalr->ruleLength[r] + 1;
+    }
+    b->itemRule = (int*)malloc(b->numItems * sizeof(int));
+    b->itemNext = (int*)malloc(b->numItems * sizeof(int));
+    b->firstAfter = (uint64_t*)calloc((size_t)b->numItems * b->words, sizeof(uint64_t));
+    b->nullableAfter = (bool*)malloc(b->numItems * sizeof(bool));
+    
+    for (int r = 0; r <= grammar->numRules; r++) {
+        for (int dot = 0; dot <= lalr->ruleLength[r]; dot++) {
+            int item = b->itemBase[r] + dot;
+            b->itemRule[item] = r;
+            b->itemNext[item] = (dot < lalr->ruleLength[r]) ? b->rhs[r][dot] : -1;
+            
+            bool allNullable = true;
+            for (int k = dot + 1; k < lalr->ruleLength[r] && allNullable; k++) {
+                int X = b->rhs[r][k];
+                if (X < T) {
+                    b->firstAfter[(size_t)item * b->words + X / 64] |= 1ULL << (X % 64);
+                    allNullable = false;
+                } else {
+                    lookaheadUnion(b->firstAfter + (size_t)item * b->words, firstNT + (size_t)(X - T) * b->words, b->words);
+                    allNullable = nullable[X - T];
+                }
+            }
+            b->nullableAfter[item] = allNullable;
+        }
+    }
+    free(firstNT);
+    free(nullable);
+    
+    b->closure = (int*)malloc(b->numItems * sizeof(int));
+    b->inClosure = (int*)calloc(b->numItems, sizeof(int));
+    b->stamp = 0;
+    b->closureLA = (uint64_t*)malloc((size_t)b->numItems * b->words * sizeof(uint64_t));
+    
+    // LR(0) automaton
+    b->numStates = 0;
+    b->capacity = 64;
+    b->kernel = (int**)malloc(b->capacity * sizeof(int*));
+    b->kernelSize = (int*)malloc(b->capacity * sizeof(int));
+    b->gotoOn = (int**)malloc(b->capacity * sizeof(int*));
+    b->lookahead = (uint64_t**)malloc(b->capacity * sizeof(uint64_t*));
+    
+    int startItem = b->itemBase[0];
+    lalrFindOrAddState(b, &startItem, 1);
+    int* advanced = (int*)malloc(b->numItems * sizeof(int));
+    
+    for (int s = 0; s < b->numStates; s++) {
+        lalrClosure(b, s, false);
+        for (int i = 0; i < b->closureSize; i++) {
+            int X = b->itemNext[b->closure[i]];
+            if (X < 0 || b->gotoOn[s][X] != -1) continue;
+            
+            // Kernel of goto(s, X), kept sorted so equal kernels compare equal
+            int count = 0;
+            for (int j = i; j < b->closureSize; j++) {
+                if (b->itemNext[b->closure[j]] != X) continue;
+                int item = b->closure[j] + 1;
+                int k = count++;
+                while (k > 0 && advanced[k - 1] > item) {
+                    advanced[k] = advanced[k - 1];
+                    k--;
+                }
+                advanced[k] = item;
+            }
+            int target = lalrFindOrAddState(b, advanced, count);
+            b->gotoOn[s][X] = target;
+        }
+    }
+    free(advanced);
+    
+    // Propagate lookaheads along the goto edges until they stop growing
+    b->lookahead[0][dollarIndex / 64] |= 1ULL << (dollarIndex % 64);
+    changed = true;
+    while (changed) {
+        changed = false;
+        for (int s = 0; s < b->numStates; s++) {
+            lalrClosure(b, s, true);
+            for (int i = 0; i < b->closureSize; i++) {
+                int item = b->closure[i];
+                int X = b->itemNext[item];
+                if (X < 0) continue;
+                
+                int target = b->gotoOn[s][X];
+                int k = 0;
+                while (b->kernel[target][k] != item + 1) k++;
+                if (lookaheadUnion(b->lookahead[target] + (size_t)k * b->words,
+                                   b->closureLA + (size_t)item * b->words, b->words)) {
+                    changed = true;
+                }
+            }
+        }
+    }
+    
+    // Fill in the tables
+    lalr->numStates = b->numStates;
+    initParseTable(&lalr->action, b->numStates, T);
+    initParseTable(&lalr->gotoTable, b->numStates, N);
+    
+    for (int s = 0; s < b->numStates; s++) {
+        for (int X = 0; X < b->numSymbols; X++) {
+            int target = b->gotoOn[s][X];
+            if (target < 0) continue;
+            if (X < T) {
+                setParseTableEntry(&lalr->action, s, X, target);
+            } else {
+                setParseTableEntry(&lalr->gotoTable, s, X - T, target);
+            }
+        }
+        
+        lalrClosure(b, s, true);
+        for (int i = 0; i < b->closureSize; i++) {
+            int item = b->closure[i];
+            if (b->itemNext[item] != -1) continue;
+            
+            int r = b->itemRule[item];
+            int entry = (r == 0) ? LALR_ACCEPT : LALR_REDUCE(r);
+            uint64_t* la = b->closureLA + (size_t)item * b->words;
+            
+            for (int a = 0; a < T; a++) {
+                if (!(la[a / 64] & (1ULL << (a % 64)))) continue;
+                
+                int existing = getParseTableEntry(&lalr->action, s, a);
+                if (existing == PARSE_TABLE_ERROR) {
+                    setParseTableEntry(&lalr->action, s, a, entry);
+                } else if (existing >= 0) {
+                    lalr->shiftReduceConflicts++;
+                } else if (existing != entry) {
+                    lalr->reduceReduceConflicts++;
+                    if (LALR_RULE(entry) < LALR_RULE(existing)) {
+                        setParseTableEntry(&lalr->action, s, a, entry);
+                    }
+                }
+            }
+        }
+    }
+    
+    if (parseTableMemory(&lalr->action) > PARSE_TABLE_DENSE_LIMIT) compressParseTable(&lalr->action);
+    if (parseTableMemory(&lalr->gotoTable) > PARSE_TABLE_DENSE_LIMIT) compressParseTable(&lalr->gotoTable);
+    
+    // Release the construction data
+    for (int s = 0; s < b->numStates; s++) {
+        free(b->kernel[s]);
+        free(b->gotoOn[s]);
+        free(b->lookahead[s]);
+    }
+    free(b->kernel);
+    free(b->kernelSize);
+    free(b->gotoOn);
+    free(b->lookahead);
+    for (int r = 0; r <= grammar->numRules; r++) free(b->rhs[r]);
+    free(b->rhs);
+    for (int A = 0; A < N; A++) free(b->rulesOf[A]);
+    free(b->rulesOf);
+    free(b->numRulesOf);
+    free(b->itemBase);
+    free(b->itemRule);
+    free(b->itemNext);
+    free(b->firstAfter);
+    free(b->nullableAfter);
+    free(b->closure);
+    free(b->inClosure);
+    free(b->closureLA);
+    
+    return lalr;
+}
+
+// Shift-reduce driver for tables built by createLALRTable. Builds the parse tree of the
+// LALR grammar bottom-up using the same node layout (epsilon rules get a TK_EPS leaf).
+// Errors are reported to logFile (if not NULL) and the offending token is skipped;
+// if the input runs out while recovering, no tree is returned.
+ParseTreeNode* runLALRParser(LALRTable* lalr, Token* tokens, int numTokens, FILE* logFile, bool* hadError) {
+    Grammar* grammar = lalr->grammar;
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    int dollarIndex = findTerminalIndex(grammar, DOLLAR_TOKEN);
+    
+    int capacity = 256;
+    int* states = (int*)malloc(capacity * sizeof(int));
+    ParseTreeNode** nodes = (ParseTreeNode**)malloc(capacity * sizeof(ParseTreeNode*));
+    int top = 0;
+    states[0] = 0;
+    nodes[0] = NULL;
+    
+    int currentToken = 0;
+    bool error = false;
+    ParseTreeNode* root = NULL;
+    
+    while (currentToken < numTokens) {
+        int a = tokens[currentToken].terminalIndex;
+        if (a == -1) {
+            if (logFile) {
+                fprintf(logFile, "Error: Unknown token %s at line %d\n",
+                        tokens[currentToken].token, tokens[currentToken].lineNumber);
+            }
+            currentToken++;
+            continue;
+        }
+        
+        int entry = getParseTableEntry(&lalr->action, states[top], a);
+        
+        if (top + 1 == capacity) {
+            capacity *= 2;
+            states = (int*)realloc(states, capacity * sizeof(int));
+            nodes = (ParseTreeNode**)realloc(nodes, capacity * sizeof(ParseTreeNode*));
+        }
+        
+        if (entry >= 0) {
+            // Shift
+            top++;
+            states[top] = entry;
+            nodes[top] = createNode(true, a, tokens[currentToken].lineNumber, tokens[currentToken].lexeme);
+            currentToken++;
+        } else if (entry == LALR_ACCEPT) {
+            root = nodes[top];
+            top--;
+            break;
+        } else if (LALR_IS_REDUCE(entry)) {
+            int r = LALR_RULE(entry);
+            int length = lalr->ruleLength[r];
+            ParseTreeNode* parent = createNode(false, lalr->ruleLhs[r], 0, NULL);
+            parent->ruleNumber = r;
+            
+            if (length == 0) {
+                ParseTreeNode* eps = createNode(true, epsilonIndex, 0, NULL);
+                eps->parent = parent;
+                parent->firstChild = eps;
+            } else {
+                // The top length nodes become the children, in order
+                parent->firstChild = nodes[top - length + 1];
+                for (int k = top - length + 1; k <= top; k++) {
+                    nodes[k]->parent = parent;
+                    nodes[k]->nextSibling = (k < top) ? nodes[k + 1] : NULL;
+                }
+            }
+            
+            top -= length;
+            int target = getParseTableEntry(&lalr->gotoTable, states[top], lalr->ruleLhs[r]);
+            top++;
+            states[top] = target;
+            nodes[top] = parent;
+        } else {
+            error = true;
+            if (logFile) {
+                fprintf(logFile, "Error: Unexpected %s (%s) at line %d\n", tokens[currentToken].token,
+                        tokens[currentToken].lexeme, tokens[currentToken].lineNumber);
+            }
+            if (a == dollarIndex) break;
+            currentToken++;
+        }
+    }
+    
+    // Anything still on the stack belongs to an incomplete parse
+    for (int k = 1; k <= top; k++) {
+        freeParseTree(nodes[k]);
+    }
+    free(states);
+    free(nodes);
+    
+    if (root == NULL) error = true;
+    if (logFile) {
+        fprintf(logFile, root != NULL && !error ? "Parsing completed successfully!\n"
+                                                : "Parsing completed with errors!\n");
+    }
+    if (hadError) *hadError = error;
+    return root;
+}
+
+// Milliseconds between two CLOCK_MONOTONIC readings, shared by the benchmarks below
+static double elapsedMs(struct timespec* start, struct timespec* end) {
+    return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+// Count nodes and depth of a parse tree. The stack holds sibling chains, tagged with
+// their depth.
+int countParseTreeNodes(ParseTreeNode* node, int depth, int* maxDepth) {
+    TreeWalkStack stack = {NULL, 0, 0};
+    int count = 0;
+    
+    if (node != NULL) pushTreeWalk(&stack, node, depth);
+    while (stack.top > 0) {
+        TreeWalkEntry entry = stack.entries[--stack.top];
+        if (entry.tag > *maxDepth) *maxDepth = entry.tag;
+        for (node = entry.node; node != NULL; node = node->nextSibling) {
+            count++;
+            if (node->firstChild != NULL) pushTreeWalk(&stack, node->firstChild, entry.tag + 1);
+        }
+    }
+    
+    free(stack.entries);
+    return count;
+}
+
+// Parse the same tokens with the LL(1) and the LALR(1) engine and compare tree size and speed.
+// The LALR tree is written to parseTreeFile in the usual inorder format.
+void compareParserEngines(Grammar* grammar, ParseTable* parseTable, LALRTable* lalr,
+                          Token* tokens, int numTokens, int iterations, const char* parseTreeFile) {
+    struct timespec start, end;
+    bool llError, lalrError;
+    double llMs = 0, lalrMs = 0;
+    ParseTreeNode* llTree = NULL;
+    ParseTreeNode* lalrTree = NULL;
+    
+    for (int i = 0; i < iterations; i++) {
+        freeParseTree(llTree);
+        freeParseTree(lalrTree);
+        
+        resolveTokenTerminals(grammar, tokens, numTokens);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        llTree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &llError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        llMs += elapsedMs(&start, &end);
+        
+        resolveTokenTerminals(lalr->grammar, tokens, numTokens);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        lalrTree = runLALRParser(lalr, tokens, numTokens, NULL, &lalrError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        lalrMs += elapsedMs(&start, &end);
+    }
+    
+    int llDepth = 0, lalrDepth = 0;
+    int llNodes = countParseTreeNodes(llTree, 1, &llDepth);
+    int lalrNodes = countParseTreeNodes(lalrTree, 1, &lalrDepth);
+    
+    printf("\nLL(1) vs LALR(1): %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%-10s%10s%10s%14s%12s%8s\n", "Engine", "nodes", "depth", "tree bytes", "ms/parse", "errors");
+    printf("%-10s%10d%10d%14zu%12.3f%8s\n", "LL(1)", llNodes, llDepth, llNodes * sizeof(ParseTreeNode),
+           llMs / iterations, llError ? "yes" : "no");
+    printf("%-10s%10d%10d%14zu%12.3f%8s\n", "LALR(1)", lalrNodes, lalrDepth, lalrNodes * sizeof(ParseTreeNode),
+           lalrMs / iterations, lalrError ? "yes" : "no");
+    
+    FILE* traversalFile = fopen(parseTreeFile, "w");
+    if (traversalFile) {
+        fprintf(traversalFile, "Parse Tree Inorder Traversal (LALR(1)):\n");
+        fprintf(traversalFile, "============================\n\n");
+        fprintf(traversalFile, "%-20s%-15s%-20s\n", "Token/Non-Terminal", "Line Number", "Lexeme/Type");
+        fprintf(traversalFile, "------------------------------------------------------------\n");
+        inorderTraversal(lalrTree, lalr->grammar, traversalFile);
+        fclose(traversalFile);
+    } else {
+        printf("Error opening parse tree file\n");
+    }
+    
+    freeParseTree(llTree);
+    freeParseTree(lalrTree);
+}
+
+// Parse the same tokens with the LL(1) grammar and with a grammar that leaves some
+// alternatives unfactored and relies on adaptive prediction for them.
+// The adaptive tree is written to parseTreeFile in the usual inorder format.
+void compareAdaptivePrediction(Grammar* grammar, ParseTable* parseTable, Grammar* adaptiveGrammar,
+                               ParseTable* adaptiveTable, AdaptivePredictor* predictor,
+                               Token* tokens, int numTokens, int iterations, const char* parseTreeFile) {
+    struct timespec start, end;
+    bool llError, adaptiveError;
+    double llMs = 0, adaptiveMs = 0;
+    ParseTreeNode* llTree = NULL;
+    ParseTreeNode* adaptiveTree = NULL;
+    
+    for (int i = 0; i < iterations; i++) {
+        freeParseTree(llTree);
+        freeParseTree(adaptiveTree);
+        
+        resolveTokenTerminals(grammar, tokens, numTokens);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        llTree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &llError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        llMs += elapsedMs(&start, &end);
+        
+        resolveTokenTerminals(adaptiveGrammar, tokens, numTokens);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        adaptiveTree = runPredictiveParser(adaptiveGrammar, adaptiveTable, predictor, tokens, numTokens,
+                                           false, NULL, &adaptiveError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        adaptiveMs += elapsedMs(&start, &end);
+    }
+    
+    int llDepth = 0, adaptiveDepth = 0;
+    int llNodes = countParseTreeNodes(llTree, 1, &llDepth);
+    int adaptiveNodes = countParseTreeNodes(adaptiveTree, 1, &adaptiveDepth);
+    
+    int dfaStates = 0;
+    for (int d = 0; d < predictor->numDecisions; d++) {
+        dfaStates += predictor->decisions[d].numStates;
+    }
+    
+    printf("\nLL(1) vs adaptive LL(*): %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%-10s%10s%10s%12s%8s\n", "Engine", "nodes", "depth", "ms/parse", "errors");
+    printf("%-10s%10d%10d%12.3f%8s\n", "LL(1)", llNodes, llDepth, llMs / iterations, llError ? "yes" : "no");
+    printf("%-10s%10d%10d%12.3f%8s\n", "LL(*)", adaptiveNodes, adaptiveDepth, adaptiveMs / iterations,
+           adaptiveError ? "yes" : "no");
+    printf("%d decisions, %ld predictions, %ld simulated DFA edges, %d DFA states\n",
+           predictor->numDecisions, predictor->predictions, predictor->simulations, dfaStates);
+    
+    FILE* traversalFile = fopen(parseTreeFile, "w");
+    if (traversalFile) {
+        fprintf(traversalFile, "Parse Tree Inorder Traversal (adaptive LL(*)):\n");
+        fprintf(traversalFile, "============================\n\n");
+        fprintf(traversalFile, "%-20s%-15s%-20s\n", "Token/Non-Terminal", "Line Number", "Lexeme/Type");
+        fprintf(traversalFile, "------------------------------------------------------------\n");
+        inorderTraversal(adaptiveTree, adaptiveGrammar, traversalFile);
+        fclose(traversalFile);
+    } else {
+        printf("Error opening parse tree file\n");
+    }
+    
+    freeParseTree(llTree);
+    freeParseTree(adaptiveTree);
+}
+
+// Build the full and the compact LL(1) tree for the same tokens and compare their size.
+// The compact tree is written to parseTreeFile in the usual inorder format.
+void compareCompactTree(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                        int iterations, const char* parseTreeFile) {
+    struct timespec start, end;
+    bool fullError, compactError;
+    double fullMs = 0, compactMs = 0;
+    ParseTreeNode* fullTree = NULL;
+    ParseTreeNode* compactTree = NULL;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    for (int i = 0; i < iterations; i++) {
+        freeParseTree(fullTree);
+        freeParseTree(compactTree);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        fullTree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &fullError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        fullMs += elapsedMs(&start, &end);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        compactTree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, true, NULL, &compactError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        compactMs += elapsedMs(&start, &end);
+    }
+    
+    int fullDepth = 0, compactDepth = 0;
+    int fullNodes = countParseTreeNodes(fullTree, 1, &fullDepth);
+    int compactNodes = countParseTreeNodes(compactTree, 1, &compactDepth);
+    
+    printf("\nFull vs compact parse tree: %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%-10s%10s%10s%14s%12s%8s\n", "Tree", "nodes", "depth", "tree bytes", "ms/parse", "errors");
+    printf("%-10s%10d%10d%14zu%12.3f%8s\n", "full", fullNodes, fullDepth, fullNodes * sizeof(ParseTreeNode),
+           fullMs / iterations, fullError ? "yes" : "no");
+    printf("%-10s%10d%10d%14zu%12.3f%8s\n", "compact", compactNodes, compactDepth,
+           compactNodes * sizeof(ParseTreeNode), compactMs / iterations, compactError ? "yes" : "no");
+    
+    FILE* traversalFile = fopen(parseTreeFile, "w");
+    if (traversalFile) {
+        fprintf(traversalFile, "Parse Tree Inorder Traversal (compact):\n");
+        fprintf(traversalFile, "============================\n\n");
+        fprintf(traversalFile, "%-20s%-15s%-20s\n", "Token/Non-Terminal", "Line Number", "Lexeme/Type");
+        fprintf(traversalFile, "------------------------------------------------------------\n");
+        inorderTraversal(compactTree, grammar, traversalFile);
+        fclose(traversalFile);
+    } else {
+        printf("Error opening parse tree file\n");
+    }
+    
+    freeParseTree(fullTree);
+    freeParseTree(compactTree);
+}
+
+// Compare recording a derivation trace with building the tree directly, and check that
+// replaying the trace gives back the same full and compact trees
+void compareDerivationTrace(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, int iterations) {
+    struct timespec start, end;
+    bool treeError;
+    double treeMs = 0, traceMs = 0, replayMs = 0;
+    DerivationTrace trace = {NULL, 0, 0, false};
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    for (int i = 0; i < iterations; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ParseTreeNode* tree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &treeError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        treeMs += elapsedMs(&start, &end);
+        freeParseTree(tree);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        recordDerivation(grammar, parseTable, NULL, tokens, numTokens, &trace);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        traceMs += elapsedMs(&start, &end);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        tree = materializeParseTree(grammar, &trace, tokens, false);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        replayMs += elapsedMs(&start, &end);
+        freeParseTree(tree);
+    }
+    
+    ParseTreeNode* direct = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &treeError);
+    ParseTreeNode* replayed = materializeParseTree(grammar, &trace, tokens, false);
+    bool same = parseTreesEqual(direct, replayed) && treeError == trace.error;
+    int depth = 0;
+    int nodes = countParseTreeNodes(direct, 1, &depth);
+    freeParseTree(direct);
+    freeParseTree(replayed);
+    
+    direct = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, true, NULL, &treeError);
+    replayed = materializeParseTree(grammar, &trace, tokens, true);
+    same = same && parseTreesEqual(direct, replayed);
+    freeParseTree(direct);
+    freeParseTree(replayed);
+    
+    printf("\nDerivation trace vs parse tree: %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%-22s%14s%12s\n", "Mode", "bytes", "ms/parse");
+    printf("%-22s%14zu%12.3f\n", "tree", nodes * sizeof(ParseTreeNode), treeMs / iterations);
+    printf("%-22s%14zu%12.3f\n", "trace", trace.count * sizeof(uint32_t), traceMs / iterations);
+    printf("%-22s%14s%12.3f\n", "materialize from trace", "", replayMs / iterations);
+    printf("%d derivation steps, replayed trees %s\n", trace.count, same ? "identical" : "DIFFER");
+    
+    freeDerivationTrace(&trace);
+}
+
+// Example callback consumer: collects simple metrics in one pass without a tree
+typedef struct {
+    Grammar* grammar;
+    int stmtIndex;
+    int declarationIndex;
+    int functionIndex;
+    int depth;
+    int maxDepth;
+    int events;
+    int statements;
+    int declarations;
+    int functions;
+    int errors;
+    int firstErrorLine;
+    char firstError[200];
+} ParseMetrics;
+
+static void metricsEnter(void* userData, int rule, int line) {
+    ParseMetrics* metrics = (ParseMetrics*)userData;
+    int lhs = metrics->grammar->rules[rule]->symbols->head->id.nonTerminal;
+    (void)line;
+    metrics->events++;
+    if (++metrics->depth > metrics->maxDepth) metrics->maxDepth = metrics->depth;
+    if (lhs == metrics->stmtIndex) metrics->statements++;
+    if (lhs == metrics->declarationIndex) metrics->declarations++;
+    if (lhs == metrics->functionIndex) metrics->functions++;
+}
+
+static void metricsToken(void* userData, int terminal, const char* lexeme, int line) {
+    (void)terminal;
+    (void)lexeme;
+    (void)line;
+    ((ParseMetrics*)userData)->events++;
+}
+
+static void metricsExit(void* userData, int rule) {
+    ParseMetrics* metrics = (ParseMetrics*)userData;
+    (void)rule;
+    metrics->events++;
+    metrics->depth--;
+}
+
+static void metricsSyntaxError(void* userData, int line, const char* found, const char* message) {
+    ParseMetrics* metrics = (ParseMetrics*)userData;
+    if (metrics->errors++ == 0) {
+        metrics->firstErrorLine = line;
+        snprintf(metrics->firstError, sizeof(metrics->firstError), "%s (found %s)", message, found);
+    }
+}
+
+// Run the callback parser with the metrics consumer and time it against building the tree
+void runParseMetrics(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, int iterations) {
+    struct timespec start, end;
+    bool treeError;
+    double treeMs = 0, eventMs = 0;
+    ParseMetrics metrics;
+    ParseCallbacks callbacks = {metricsEnter, metricsToken, metricsExit, metricsSyntaxError, &metrics};
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    for (int i = 0; i < iterations; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ParseTreeNode* tree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &treeError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        treeMs += elapsedMs(&start, &end);
+        freeParseTree(tree);
+        
+        memset(&metrics, 0, sizeof(metrics));
+        metrics.grammar = grammar;
+        metrics.stmtIndex = findNonTerminalIndex(grammar, "stmt");
+        metrics.declarationIndex = findNonTerminalIndex(grammar, "declaration");
+        metrics.functionIndex = findNonTerminalIndex(grammar, "function");
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        parseWithCallbacks(grammar, parseTable, NULL, tokens, numTokens, &callbacks);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        eventMs += elapsedMs(&start, &end);
+    }
+    
+    printf("\nEvent-driven parse: %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%d events, %d functions, %d declarations, %d statements, max depth %d, %d syntax errors\n",
+           metrics.events, metrics.functions, metrics.declarations, metrics.statements, metrics.maxDepth,
+           metrics.errors);
+    if (metrics.errors > 0) {
+        printf("First syntax error at line %d: %s\n", metrics.firstErrorLine, metrics.firstError);
+    }
+    printf("%.3f ms/parse with callbacks, %.3f ms/parse building the tree\n", eventMs / iterations, treeMs / iterations);
+}
+
+// Abstract syntax tree built directly while parsing, without the concrete parse tree.
+// Field use by kind:
+//   AST_PROGRAM          child[0] other functions, child[1] main function
+//   AST_FUNCTION         name, child[0] input parameters, child[1] output parameters, child[2] body
+//   AST_PARAMETER        name, child[0] type
+//   AST_TYPE             op (TK_INT, TK_REAL, TK_RECORD, TK_UNION or TK_RUID), name
+//   AST_TYPE_DEFINITION  op (TK_RECORD or TK_UNION), name, child[0] fields
+//   AST_FIELD            name, child[0] type
+//   AST_DEFINETYPE       op (TK_RECORD or TK_UNION), name (new name), child[0] existing name
+//   AST_DECLARATION      name, op (TK_GLOBAL or 0), child[0] type
+//   AST_ASSIGNMENT       child[0] target, child[1] expression
+//   AST_WHILE            child[0] condition, child[1] body
+//   AST_IF               child[0] condition, child[1] then part, child[2] else part
+//   AST_CALL             name, child[0] input arguments, child[1] output arguments
+//   AST_READ, AST_WRITE  child[0] variable
+//   AST_RETURN           child[0] returned identifiers
+//   AST_BINARY           op (operator terminal), child[0] left, child[1] right
+//   AST_NOT              child[0] operand
+//   AST_RECORD_ACCESS    name (field), child[0] record
+//   AST_ID, AST_NUM, AST_RNUM, AST_TOKEN   leaves, op is the terminal and name the lexeme
+// Lists (functions, parameters, body items, fields, arguments) are chained through next.
+typedef enum {
+    AST_PROGRAM, AST_FUNCTION, AST_PARAMETER, AST_TYPE, AST_TYPE_DEFINITION, AST_FIELD,
+    AST_DEFINETYPE, AST_DECLARATION, AST_ASSIGNMENT, AST_WHILE, AST_IF, AST_CALL, AST_READ,
+    AST_WRITE, AST_RETURN, AST_BINARY, AST_NOT, AST_RECORD_ACCESS, AST_ID, AST_NUM, AST_RNUM,
+    AST_TOKEN
+} AstKind;
+
+static const char* astKindNames[] = {
+    "program", "function", "parameter", "type", "typeDefinition", "field",
+    "definetype", "declaration", "assignment", "while", "if", "call", "read",
+    "write", "return", "binary", "not", "recordAccess", "id", "num", "rnum",
+    "token"
+};
+
+// Children that are lists get a label line in printAst
+static const char* astChildLabels[][3] = {
+    {"functions", "main", NULL}, {"input", "output", "body"}, {NULL, NULL, NULL}, {NULL, NULL, NULL},
+    {NULL, NULL, NULL}, {NULL, NULL, NULL}, {NULL, NULL, NULL}, {NULL, NULL, NULL},
+    {NULL, NULL, NULL}, {NULL, "body", NULL}, {NULL, "then", "else"}, {"inputs", "outputs", NULL},
+    {NULL, NULL, NULL}, {NULL, NULL, NULL}, {NULL, NULL, NULL}, {NULL, NULL, NULL},
+    {NULL, NULL, NULL}, {NULL, NULL, NULL}, {NULL, NULL, NULL}, {NULL, NULL, NULL},
+    {NULL, NULL, NULL}, {NULL, NULL, NULL}
+};
+
+typedef struct AstNode {
+    AstKind kind;
+    int line;
+    int op;
+    const char* name;
+    struct AstNode* child[3];
+    struct AstNode* next;
+} AstNode;
+
+// Bump allocator for AST nodes and names, freed all at once
+#define ARENA_BLOCK_SIZE 65536
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    size_t size;
+    char data[];
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* head;
+    size_t bytes;
+} Arena;
+
+void* arenaAlloc(Arena* arena, size_t size) {
+    size = (size + 15) & ~(size_t)15;
+    if (arena->head == NULL || arena->head->used + size > arena->head->size) {
+        size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + blockSize);
+        block->next = arena->head;
+        block->used = 0;
+        block->size = blockSize;
+        arena->head = block;
+    }
+    void* result = arena->head->data + arena->head->used;
+    arena->head->used += size;
+    arena->bytes += size;
+    return result;
+}
+
+char* arenaStrdup(Arena* arena, const char* text) {
+    size_t length = strlen(text) + 1;
+    char* copy = (char*)arenaAlloc(arena, length);
+    memcpy(copy, text, length);
+    return copy;
+}
+
+void arenaFree(Arena* arena) {
+    while (arena->head != NULL) {
+        ArenaBlock* next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    arena->bytes = 0;
+}
+
+// Side table of AST actions keyed by rule. Positions index the RHS of the rule; a
+// non-terminal's value is what its own action built, a token's value is a leaf for
+// identifiers, numbers, types and operators and NULL for everything else.
+// Rules without an entry pass up their only non-NULL value (or NULL).
+typedef enum {
+    AST_ACTION_MAKE,          // new node of kind from name, op and child positions
+    AST_ACTION_CONCAT,        // join the lists at the child positions
+    AST_ACTION_RETAG,         // the value at child[0] with its kind changed
+    AST_ACTION_FOLD,          // child[0] combined left to right with the partial binaries at child[1]
+    AST_ACTION_RECORD_ACCESS  // identifier at child[0] followed by the field list at child[1]
+} AstActionType;
+
+typedef struct {
+    const char* rule;     // "lhs rhs..." exactly as in grammar.txt
+    AstActionType action;
+    AstKind kind;
+    int name;             // position supplying name, -1 if none
+    int op;               // position supplying op, -1 if none
+    int child[4];         // positions of children or list parts, -1 if unused
+    int next;             // position whose value becomes next, -1 if none
+    int chain[2];         // append the list at chain[1] to the one at chain[0] first
+} AstRuleAction;
+
+static const AstRuleAction astRuleActions[] = {
+    {"program otherFunctions mainFunction", AST_ACTION_MAKE, AST_PROGRAM, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"mainFunction TK_MAIN stmts TK_END", AST_ACTION_MAKE, AST_FUNCTION, 0, -1, {-1, -1, 1, -1}, -1, {-1, -1}},
+    {"otherFunctions function otherFunctions", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"function TK_FUNID input_par output_par TK_SEM stmts TK_END", AST_ACTION_MAKE, AST_FUNCTION, 0, -1, {1, 2, 4, -1}, -1, {-1, -1}},
+    {"parameter_list dataType TK_ID remaining_list", AST_ACTION_MAKE, AST_PARAMETER, 1, -1, {0, -1, -1, -1}, 2, {-1, -1}},
+    {"constructedDatatype TK_RECORD TK_RUID", AST_ACTION_MAKE, AST_TYPE, 1, 0, {-1, -1, -1, -1}, -1, {-1, -1}},
+    {"constructedDatatype TK_UNION TK_RUID", AST_ACTION_MAKE, AST_TYPE, 1, 0, {-1, -1, -1, -1}, -1, {-1, -1}},
+    {"constructedDatatype TK_RUID", AST_ACTION_RETAG, AST_TYPE, -1, -1, {0, -1, -1, -1}, -1, {-1, -1}},
+    {"stmts typeDefinitions declarations otherStmts returnStmt", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, 2, 3}, -1, {-1, -1}},
+    {"typeDefinitions actualOrRedefined typeDefinitions", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"typeDefinition TK_RECORD TK_RUID fieldDefinitions TK_ENDRECORD", AST_ACTION_MAKE, AST_TYPE_DEFINITION, 1, 0, {2, -1, -1, -1}, -1, {-1, -1}},
+    {"typeDefinition TK_UNION TK_RUID fieldDefinitions TK_ENDUNION", AST_ACTION_MAKE, AST_TYPE_DEFINITION, 1, 0, {2, -1, -1, -1}, -1, {-1, -1}},
+    {"fieldDefinitions fieldDefinition fieldDefinition moreFields", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, 2, -1}, -1, {-1, -1}},
+    {"fieldDefinition TK_TYPE fieldType TK_COLON TK_FIELDID TK_SEM", AST_ACTION_MAKE, AST_FIELD, 3, -1, {1, -1, -1, -1}, -1, {-1, -1}},
+    {"moreFields fieldDefinition moreFields", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"declarations declaration declarations", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"declaration TK_TYPE dataType TK_COLON TK_ID global_or_not TK_SEM", AST_ACTION_MAKE, AST_DECLARATION, 3, 4, {1, -1, -1, -1}, -1, {-1, -1}},
+    {"otherStmts stmt otherStmts", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"assignmentStmt singleOrRecId TK_ASSIGNOP arithmeticExpression TK_SEM", AST_ACTION_MAKE, AST_ASSIGNMENT, -1, -1, {0, 2, -1, -1}, -1, {-1, -1}},
+    {"singleOrRecId TK_ID option_single_constructed", AST_ACTION_RECORD_ACCESS, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"option_single_constructed oneExpansion moreExpansions", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"moreExpansions oneExpansion moreExpansions", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"funCallStmt outputParameters TK_CALL TK_FUNID TK_WITH TK_PARAMETERS inputParameters TK_SEM", AST_ACTION_MAKE, AST_CALL, 2, -1, {5, 0, -1, -1}, -1, {-1, -1}},
+    {"iterativeStmt TK_WHILE TK_OP booleanExpression TK_CL stmt otherStmts TK_ENDWHILE", AST_ACTION_MAKE, AST_WHILE, -1, -1, {2, 4, -1, -1}, -1, {4, 5}},
+    {"conditionalStmt TK_IF TK_OP booleanExpression TK_CL TK_THEN stmt otherStmts elsePart", AST_ACTION_MAKE, AST_IF, -1, -1, {2, 5, 7, -1}, -1, {5, 6}},
+    {"elsePart TK_ELSE stmt otherStmts TK_ENDIF", AST_ACTION_CONCAT, 0, -1, -1, {1, 2, -1, -1}, -1, {-1, -1}},
+    {"ioStmt TK_READ TK_OP var TK_CL TK_SEM", AST_ACTION_MAKE, AST_READ, -1, -1, {2, -1, -1, -1}, -1, {-1, -1}},
+    {"ioStmt TK_WRITE TK_OP var TK_CL TK_SEM", AST_ACTION_MAKE, AST_WRITE, -1, -1, {2, -1, -1, -1}, -1, {-1, -1}},
+    {"arithmeticExpression term expPrime", AST_ACTION_FOLD, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"expPrime lowPrecedenceOperators term expPrime", AST_ACTION_MAKE, AST_BINARY, -1, 0, {-1, 1, -1, -1}, 2, {-1, -1}},
+    {"term factor termPrime", AST_ACTION_FOLD, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"termPrime highPrecedenceOperators factor termPrime", AST_ACTION_MAKE, AST_BINARY, -1, 0, {-1, 1, -1, -1}, 2, {-1, -1}},
+    {"booleanExpression TK_OP booleanExpression TK_CL logicalOp TK_OP booleanExpression TK_CL", AST_ACTION_MAKE, AST_BINARY, -1, 3, {1, 5, -1, -1}, -1, {-1, -1}},
+    {"booleanExpression var relationalOp var", AST_ACTION_MAKE, AST_BINARY, -1, 1, {0, 2, -1, -1}, -1, {-1, -1}},
+    {"booleanExpression TK_NOT TK_OP booleanExpression TK_CL", AST_ACTION_MAKE, AST_NOT, -1, -1, {2, -1, -1, -1}, -1, {-1, -1}},
+    {"returnStmt TK_RETURN optionalReturn TK_SEM", AST_ACTION_MAKE, AST_RETURN, -1, -1, {1, -1, -1, -1}, -1, {-1, -1}},
+    {"idList TK_ID more_ids", AST_ACTION_CONCAT, 0, -1, -1, {0, 1, -1, -1}, -1, {-1, -1}},
+    {"definetypestmt TK_DEFINETYPE A TK_RUID TK_AS TK_RUID", AST_ACTION_MAKE, AST_DEFINETYPE, 4, 1, {2, -1, -1, -1}, -1, {-1, -1}},
+};
+
+// Terminals that become AST leaves, with the kind of leaf
+static const struct {
+    const char* terminal;
+    AstKind kind;
+} astLeafTokens[] = {
+    {"TK_ID", AST_ID}, {"TK_FIELDID", AST_ID}, {"TK_FUNID", AST_ID}, {"TK_RUID", AST_ID}, {"TK_MAIN", AST_ID},
+    {"TK_NUM", AST_NUM}, {"TK_RNUM", AST_RNUM}, {"TK_INT", AST_TYPE}, {"TK_REAL", AST_TYPE},
+    {"TK_RECORD", AST_TOKEN}, {"TK_UNION", AST_TOKEN}, {"TK_GLOBAL", AST_TOKEN},
+    {"TK_PLUS", AST_TOKEN}, {"TK_MINUS", AST_TOKEN}, {"TK_MUL", AST_TOKEN}, {"TK_DIV", AST_TOKEN},
+    {"TK_LT", AST_TOKEN}, {"TK_LE", AST_TOKEN}, {"TK_EQ", AST_TOKEN}, {"TK_GT", AST_TOKEN},
+    {"TK_GE", AST_TOKEN}, {"TK_NE", AST_TOKEN}, {"TK_AND", AST_TOKEN}, {"TK_OR", AST_TOKEN},
+};
+
+// AST construction state, driven by the parseWithCallbacks events. Every enter opens a
+// frame on the value stack, tokens and finished non-terminals push one value each, and
+// exit replaces the frame by the value its rule's action builds.
+typedef struct {
+    Grammar* grammar;
+    const AstRuleAction** actionOf;   // per rule, NULL for the default action
+    int* ruleLength;                  // RHS length without epsilon
+    int* leafKind;                    // per terminal, -1 if the token has no value
+} AstRules;
+
+typedef struct {
+    AstRules* rules;
+    Arena arena;
+    AstNode** values;
+    int numValues;
+    int valueCapacity;
+    int* frameBase;
+    int* frameLine;
+    int numFrames;
+    int frameCapacity;
+    int nodes;
+} AstBuilder;
+
+static AstNode* newAstNode(AstBuilder* builder, AstKind kind, int line) {
+    AstNode* node = (AstNode*)arenaAlloc(&builder->arena, sizeof(AstNode));
+    node->kind = kind;
+    node->line = line;
+    node->op = 0;
+    node->name = NULL;
+    node->child[0] = node->child[1] = node->child[2] = NULL;
+    node->next = NULL;
+    builder->nodes++;
+    return node;
+}
+
+static AstNode* astAppend(AstNode* list, AstNode* tail) {
+    if (list == NULL) return tail;
+    AstNode* last = list;
+    while (last->next != NULL) {
+        last = last->next;
+    }
+    last->next = tail;
+    return list;
+}
+
+static void pushAstValue(AstBuilder* builder, AstNode* value) {
+    if (builder->numValues == builder->valueCapacity) {
+        builder->valueCapacity *= 2;
+        builder->values = (AstNode**)realloc(builder->values, builder->valueCapacity * sizeof(AstNode*));
+    }
+    builder->values[builder->numValues++] = value;
+}
+
+static void astEnter(void* userData, int rule, int line) {
+    AstBuilder* builder = (AstBuilder*)userData;
+    (void)rule;
+    if (builder->numFrames == builder->frameCapacity) {
+        builder->frameCapacity *= 2;
+        builder->frameBase = (int*)realloc(builder->frameBase, builder->frameCapacity * sizeof(int));
+        builder->frameLine = (int*)realloc(builder->frameLine, builder->frameCapacity * sizeof(int));
+    }
+    builder->frameBase[builder->numFrames] = builder->numValues;
+    builder->frameLine[builder->numFrames++] = line;
+}
+
+static void astToken(void* userData, int terminal, const char* lexeme, int line) {
+    AstBuilder* builder = (AstBuilder*)userData;
+    AstNode* leaf = NULL;
+    if (builder->rules->leafKind[terminal] >= 0) {
+        leaf = newAstNode(builder, (AstKind)builder->rules->leafKind[terminal], line);
+        leaf->op = terminal;
+        leaf->name = arenaStrdup(&builder->arena, lexeme);
+    }
+    pushAstValue(builder, leaf);
+}
+
+static void astExit(void* userData, int rule) {
+    AstBuilder* builder = (AstBuilder*)userData;
+    int base = builder->frameBase[--builder->numFrames];
+    int line = builder->frameLine[builder->numFrames];
+    AstNode** v = &builder->values[base];
+    int count = builder->numValues - base;
+    const AstRuleAction* action = builder->rules->actionOf[rule];
+    AstNode* result = NULL;
+    
+    // Error recovery can leave a frame short of values, such a rule builds nothing
+    if (count != builder->rules->ruleLength[rule]) {
+        action = NULL;
+        count = 0;
+    }
+    
+    if (action == NULL) {
+        for (int i = 0; i < count; i++) {
+            if (v[i] == NULL) continue;
+            if (result != NULL) {
+                result = NULL;
+                break;
+            }
+            result = v[i];
+        }
+    } else {
+        if (action->chain[0] >= 0) {
+            v[action->chain[0]] = astAppend(v[action->chain[0]], v[action->chain[1]]);
+        }
+        
+        switch (action->action) {
+            case AST_ACTION_MAKE:
+                result = newAstNode(builder, action->kind, line);
+                if (action->name >= 0 && v[action->name] != NULL) {
+                    result->name = v[action->name]->name;
+                    result->line = v[action->name]->line;
+                }
+                if (action->op >= 0 && v[action->op] != NULL) {
+                    result->op = v[action->op]->op;
+                }
+                for (int i = 0; i < 3; i++) {
+                    if (action->child[i] >= 0) result->child[i] = v[action->child[i]];
+                }
+                if (action->next >= 0) {
+                    result->next = v[action->next];
+                }
+                break;
+            
+            case AST_ACTION_CONCAT:
+                for (int i = 3; i >= 0; i--) {
+                    if (action->child[i] < 0) continue;
+                    result = (result == NULL) ? v[action->child[i]] : astAppend(v[action->child[i]], result);
+                }
+                break;
+            
+            case AST_ACTION_RETAG:
+                result = v[action->child[0]];
+                if (result != NULL) result->kind = action->kind;
+                break;
+            
+            case AST_ACTION_FOLD:
+                // a op1 b op2 c arrives as a and [op1 b, op2 c], and folds to ((a op1 b) op2 c)
+                result = v[action->child[0]];
+                for (AstNode* partial = v[action->child[1]]; partial != NULL; ) {
+                    AstNode* next = partial->next;
+                    partial->next = NULL;
+                    partial->child[0] = result;
+                    partial->line = result ? result->line : partial->line;
+                    result = partial;
+                    partial = next;
+                }
+                break;
+            
+            case AST_ACTION_RECORD_ACCESS:
+                result = v[action->child[0]];
+                for (AstNode* field = v[action->child[1]]; field != NULL; ) {
+                    AstNode* next = field->next;
+                    AstNode* access = newAstNode(builder, AST_RECORD_ACCESS, field->line);
+                    access->name = field->name;
+                    access->child[0] = result;
+                    result = access;
+                    field = next;
+                }
+                break;
+        }
+    }
+    
+    builder->numValues = base;
+    pushAstValue(builder, result);
+}
+
+void freeAstRules(AstRules* rules) {
+    if (rules == NULL) return;
+    free(rules->actionOf);
+    free(rules->ruleLength);
+    free(rules->leafKind);
+    free(rules);
+}
+
+// Key the AST action table by rule number for grammar. Returns NULL if some action
+// does not match a rule of the grammar.
+AstRules* createAstRules(Grammar* grammar) {
+    AstRules* rules = (AstRules*)malloc(sizeof(AstRules));
+    rules->grammar = grammar;
+    rules->actionOf = (const AstRuleAction**)calloc(grammar->numRules + 1, sizeof(AstRuleAction*));
+    rules->ruleLength = (int*)calloc(grammar->numRules + 1, sizeof(int));
+    rules->leafKind = (int*)malloc(grammar->numTerminals * sizeof(int));
+    
+    int epsilonIndex = findTerminalIndex(grammar, EPSILON_TOKEN);
+    char ruleText[MAX_RULE_LENGTH * 4];
+    int matched = 0;
+    int numActions = sizeof(astRuleActions) / sizeof(astRuleActions[0]);
+    
+    for (int i = 1; i <= grammar->numRules; i++) {
+        Symbol* sym = grammar->rules[i]->symbols->head;
+        int length = snprintf(ruleText, sizeof(ruleText), "%s", grammar->nonTerminals[sym->id.nonTerminal]);
+        for (sym = sym->next; sym != NULL; sym = sym->next) {
+            const char* name = sym->isTerminal ? grammar->terminals[sym->id.terminal] : grammar->nonTerminals[sym->id.nonTerminal];
+            length += snprintf(ruleText + length, sizeof(ruleText) - length, " %s", name);
+            if (!(sym->isTerminal && sym->id.terminal == epsilonIndex)) rules->ruleLength[i]++;
+        }
+        for (int a = 0; a < numActions; a++) {
+            if (strcmp(astRuleActions[a].rule, ruleText) == 0) {
+                rules->actionOf[i] = &astRuleActions[a];
+                matched++;
+                break;
+            }
+        }
+    }
+    
+    for (int t = 0; t < grammar->numTerminals; t++) {
+        rules->leafKind[t] = -1;
+        for (size_t k = 0; k < sizeof(astLeafTokens) / sizeof(astLeafTokens[0]); k++) {
+            if (strcmp(grammar->terminals[t], astLeafTokens[k].terminal) == 0) {
+                rules->leafKind[t] = astLeafTokens[k].kind;
+                break;
+            }
+        }
+    }
+    
+    if (matched != numActions) {
+        printf("Error: %d of %d AST actions do not match a grammar rule\n", numActions - matched, numActions);
+        freeAstRules(rules);
+        return NULL;
+    }
+    return rules;
+}
+
+// Build the AST for the tokens in one parsing pass. The nodes live in *arena until
+// arenaFree. Subtrees around syntax errors are left out.
+AstNode* buildAst(AstRules* rules, ParseTable* parseTable, Token* tokens, int numTokens, Arena* arena,
+                  int* numNodes, bool* hadError) {
+    AstBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.rules = rules;
+    builder.arena = *arena;
+    builder.valueCapacity = builder.frameCapacity = 64;
+    builder.values = (AstNode**)malloc(builder.valueCapacity * sizeof(AstNode*));
+    builder.frameBase = (int*)malloc(builder.frameCapacity * sizeof(int));
+    builder.frameLine = (int*)malloc(builder.frameCapacity * sizeof(int));
+    
+    ParseCallbacks callbacks = {astEnter, astToken, astExit, NULL, &builder};
+    bool ok = parseWithCallbacks(rules->grammar, parseTable, NULL, tokens, numTokens, &callbacks);
+    
+    // The start symbol's value comes first, followed only by the NULL of the $ token
+    AstNode* root = builder.numValues > 0 ? builder.values[0] : NULL;
+    
+    *arena = builder.arena;
+    if (numNodes) *numNodes = builder.nodes;
+    if (hadError) *hadError = !ok;
+    free(builder.values);
+    free(builder.frameBase);
+    free(builder.frameLine);
+    return root;
+}
+
+// Indented dump of an AST, list items at the same depth
+void printAst(AstNode* node, Grammar* grammar, int depth, FILE* outFile) {
+    for (; node != NULL; node = node->next) {
+        fprintf(outFile, "%*s%s", depth * 2, "", astKindNames[node->kind]);
+        if (node->op > 0 || node->kind >= AST_ID) fprintf(outFile, " %s", grammar->terminals[node->op]);
+        if (node->name != NULL) fprintf(outFile, " '%s'", node->name);
+        fprintf(outFile, " (line %d)\n", node->line);
+        for (int i = 0; i < 3; i++) {
+            const char* label = astChildLabels[node->kind][i];
+            if (label != NULL && node->child[i] != NULL) {
+                fprintf(outFile, "%*s%s:\n", (depth + 1) * 2, "", label);
+                printAst(node->child[i], grammar, depth + 2, outFile);
+            } else {
+                printAst(node->child[i], grammar, depth + 1, outFile);
+            }
+        }
+    }
+}
+
+// Count the nodes reachable from an AST
+int countAstNodes(AstNode* node) {
+    int count = 0;
+    for (; node != NULL; node = node->next) {
+        count++;
+        for (int i = 0; i < 3; i++) {
+            count += countAstNodes(node->child[i]);
+        }
+    }
+    return count;
+}
+
+// Build the AST for the tokens, write it to astFile and compare its size with the parse tree
+void compareAstWithParseTree(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                             int iterations, const char* astFile) {
+    struct timespec start, end;
+    bool treeError, astError = false;
+    double treeMs = 0, astMs = 0;
+    Arena arena = {NULL, 0};
+    AstNode* ast = NULL;
+    int allocated = 0;
+    
+    AstRules* rules = createAstRules(grammar);
+    if (rules == NULL) return;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    for (int i = 0; i < iterations; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ParseTreeNode* tree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &treeError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        treeMs += elapsedMs(&start, &end);
+        freeParseTree(tree);
+        
+        arenaFree(&arena);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ast = buildAst(rules, parseTable, tokens, numTokens, &arena, &allocated, &astError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        astMs += elapsedMs(&start, &end);
+    }
+    
+    ParseTreeNode* tree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &treeError);
+    int depth = 0;
+    int treeNodes = countParseTreeNodes(tree, 1, &depth);
+    freeParseTree(tree);
+    
+    printf("\nParse tree vs AST: %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%-12s%10s%14s%12s\n", "Tree", "nodes", "bytes", "ms/parse");
+    printf("%-12s%10d%14zu%12.3f\n", "parse tree", treeNodes, treeNodes * sizeof(ParseTreeNode), treeMs / iterations);
+    printf("%-12s%10d%14zu%12.3f\n", "AST", countAstNodes(ast), arena.bytes, astMs / iterations);
+    printf("%d AST nodes allocated%s\n", allocated, astError ? ", input has syntax errors" : "");
+    
+    FILE* outFile = fopen(astFile, "w");
+    if (outFile) {
+        printAst(ast, grammar, 0, outFile);
+        fclose(outFile);
+        printf("AST has been written to %s\n", astFile);
+    } else {
+        printf("Error opening AST file\n");
+    }
+    
+    arenaFree(&arena);
+    freeAstRules(rules);
+}
+
+// Time the sequential parse against parsing the functions on numThreads threads
+void compareParallelParse(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                          int numThreads, int iterations) {
+    struct timespec start, end;
+    bool sequentialError, parallelError;
+    double sequentialMs = 0, parallelMs = 0;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    ParseTreeNode* sequential = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &sequentialError);
+    ParseTreeNode* parallel = parseFunctionsInParallel(grammar, parseTable, tokens, numTokens, numThreads, &parallelError);
+    bool same = parseTreesEqual(sequential, parallel) && sequentialError == parallelError;
+    freeParseTree(sequential);
+    freeParseTree(parallel);
+    
+    for (int i = 0; i < iterations; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        sequential = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &sequentialError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        sequentialMs += elapsedMs(&start, &end);
+        freeParseTree(sequential);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        parallel = parseFunctionsInParallel(grammar, parseTable, tokens, numTokens, numThreads, &parallelError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        parallelMs += elapsedMs(&start, &end);
+        freeParseTree(parallel);
+    }
+    
+    printf("\nSequential vs parallel parse: %d tokens, %d threads, %d iterations\n", numTokens, numThreads, iterations);
+    printf("%.3f ms/parse sequential, %.3f ms/parse parallel, parse trees %s\n",
+           sequentialMs / iterations, parallelMs / iterations, same ? "identical" : "DIFFER");
+}
+
+// Write the parse tree in the binary format, map it back and regenerate the inorder
+// traversal from the mapped nodes alone
+void compareBinaryParseTree(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                            const char* binaryFile, const char* parseTreeFile) {
+    struct timespec start, end;
+    bool error;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    ParseTreeNode* root = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &error);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool written = writeBinaryParseTree(root, grammar, binaryFile);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double writeMs = elapsedMs(&start, &end);
+    freeParseTree(root);
+    if (!written) return;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    BinaryParseTree* tree = mapBinaryParseTree(binaryFile, grammar);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double mapMs = elapsedMs(&start, &end);
+    if (tree == NULL) return;
+    
+    printf("\nBinary parse tree %s: %u nodes, %u lexeme bytes, %zu bytes on disk\n",
+           binaryFile, tree->header->numNodes, tree->header->lexemeBytes, tree->size);
+    printf("%.3f ms to write, %.3f ms to map and validate\n", writeMs, mapMs);
+    
+    FILE* traversalFile = fopen(parseTreeFile, "w");
+    if (traversalFile) {
+        fprintf(traversalFile, "Parse Tree Inorder Traversal:\n");
+        fprintf(traversalFile, "============================\n\n");
+        fprintf(traversalFile, "%-20s%-15s%-20s\n", "Token/Non-Terminal", "Line Number", "Lexeme/Type");
+        fprintf(traversalFile, "------------------------------------------------------------\n");
+        inorderTraversalBinary(tree, grammar, traversalFile);
+        fclose(traversalFile);
+    } else {
+        printf("Error opening parse tree file\n");
+    }
+    
+    unmapBinaryParseTree(tree);
+}
+
+// Write the tree as JSON and NDJSON, then time both emitters against /dev/null
+void compareJsonEmitters(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                         int iterations, const char* jsonFile, const char* ndjsonFile) {
+    struct timespec start, end;
+    bool error;
+    double treeMs = 0, eventMs = 0;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    ParseTreeNode* root = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &error);
+    
+    FILE* jsonOut = fopen(jsonFile, "w");
+    FILE* ndjsonOut = fopen(ndjsonFile, "w");
+    FILE* nullOut = fopen("/dev/null", "w");
+    if (!jsonOut || !ndjsonOut || !nullOut) {
+        printf("Error opening JSON output files\n");
+        if (jsonOut) fclose(jsonOut);
+        if (ndjsonOut) fclose(ndjsonOut);
+        if (nullOut) fclose(nullOut);
+        freeParseTree(root);
+        return;
+    }
+    
+    writeParseTreeJson(root, grammar, false, jsonOut);
+    writeParseTreeJson(root, grammar, true, ndjsonOut);
+    long jsonBytes = ftell(jsonOut);
+    fclose(jsonOut);
+    fclose(ndjsonOut);
+    
+    for (int i = 0; i < iterations; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        writeParseTreeJson(root, grammar, false, nullOut);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        treeMs += elapsedMs(&start, &end);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        parseToJson(grammar, parseTable, tokens, numTokens, false, nullOut);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        eventMs += elapsedMs(&start, &end);
+    }
+    fclose(nullOut);
+    freeParseTree(root);
+    
+    printf("\nJSON output: %ld bytes, %d iterations\n", jsonBytes, iterations);
+    printf("%.3f ms/tree written (%.1f MB/s), %.3f ms/parse with events (includes parsing)\n",
+           treeMs / iterations, jsonBytes / 1e3 / (treeMs / iterations), eventMs / iterations);
+}
+
+// Full tree walk counting the nodes with one symbol, what every query cost before the index
+static int countSymbolNodes(ParseTreeNode* node, bool isTerminal, int symbolIndex) {
+    TreeWalkStack stack = {NULL, 0, 0};
+    int count = 0;
+    
+    if (node != NULL) pushTreeWalk(&stack, node, 0);
+    while (stack.top > 0) {
+        for (node = stack.entries[--stack.top].node; node != NULL; node = node->nextSibling) {
+            if (node->isTerminal == isTerminal && node->symbolIndex == symbolIndex) count++;
+            if (node->firstChild != NULL) pushTreeWalk(&stack, node->firstChild, 0);
+        }
+    }
+    
+    free(stack.entries);
+    return count;
+}
+
+// Answer a few symbol queries through the index and by walking the tree
+void compareIndexedQueries(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, int iterations) {
+    const char* queries[] = {"funCallStmt", "TK_FIELDID", "TK_ID", "assignmentStmt"};
+    int numQueries = sizeof(queries) / sizeof(queries[0]);
+    struct timespec start, end;
+    bool error;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    ParseTreeNode* root = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &error);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ParseTreeIndex* index = buildParseTreeIndex(root, grammar);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double buildMs = elapsedMs(&start, &end);
+    
+    printf("\nParse tree index: %d nodes, built in %.3f ms, %d iterations per query\n",
+           index->numNodes, buildMs, iterations);
+    printf("%-20s%10s%14s%14s\n", "Symbol", "matches", "index us", "walk us");
+    
+    for (int q = 0; q < numQueries; q++) {
+        const int* ids = NULL;
+        int matches = 0, walked = 0;
+        long checksum = 0;
+        int terminal = findTerminalIndex(grammar, queries[q]);
+        bool isTerminal = terminal >= 0;
+        int symbolIndex = isTerminal ? terminal : findNonTerminalIndex(grammar, queries[q]);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            matches = querySymbolNodes(index, grammar, queries[q], &ids);
+            for (int k = 0; k < matches; k++) checksum += indexedNode(index, ids[k])->lineNumber;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double indexUs = elapsedMs(&start, &end) * 1000.0;
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int i = 0; i < iterations; i++) {
+            walked = countSymbolNodes(root, isTerminal, symbolIndex);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double walkUs = elapsedMs(&start, &end) * 1000.0;
+        
+        printf("%-20s%10d%14.3f%14.3f%s\n", queries[q], matches, indexUs / iterations, walkUs / iterations,
+               matches == walked ? "" : "  MISMATCH");
+        (void)checksum;
+    }
+    
+    freeParseTreeIndex(index);
+    freeParseTree(root);
+}
+
+// Feed the token file to a push parser a few tokens at a time, as a pipe or a lexer thread
+// would deliver them, and check the tree against the batch parse
+void comparePushParser(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                       const char* tokenFile, int chunkSize) {
+    FILE* file = fopen(tokenFile, "r");
+    if (!file) {
+        printf("Error opening token file: %s\n", tokenFile);
+        return;
+    }
+    
+    struct timespec start, end;
+    Token* chunk = (Token*)malloc(chunkSize * sizeof(Token));
+    char line[1024];
+    int pending = 0, feeds = 0;
+    bool pushError, batchError;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PushParser* state = createPushParser(grammar, parseTable);
+    while (fgets(line, sizeof(line), file)) {
+        if (!parseTokenLine(line, &chunk[pending])) continue;
+        if (++pending == chunkSize) {
+            parserFeed(state, chunk, pending);
+            pending = 0;
+            feeds++;
+        }
+    }
+    if (pending > 0) {
+        parserFeed(state, chunk, pending);
+        feeds++;
+    }
+    ParseTreeNode* pushTree = parserFinish(state, &pushError);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double pushMs = elapsedMs(&start, &end);
+    fclose(file);
+    free(chunk);
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    ParseTreeNode* batchTree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &batchError);
+    
+    printf("\nPush parser: %d feeds of up to %d tokens, %.3f ms including reading %s\n",
+           feeds, chunkSize, pushMs, tokenFile);
+    printf("Parse trees %s, errors: push %s, batch %s\n",
+           parseTreesEqual(pushTree, batchTree) ? "identical" : "DIFFER", pushError ? "yes" : "no", batchError ? "yes" : "no");
+    
+    freeParseTree(pushTree);
+    freeParseTree(batchTree);
+}
+
+// Whether the tokens on line are exactly one stmt of the parsed input
+static bool isStatementLine(IncrementalParse* inc, int line) {
+    int first = findFirstLeafOnLine(inc, line);
+    int last = findFirstLeafOnLine(inc, line + 1) - 1;
+    if (inc->error || first > last) return false;
+    
+    ParseTreeNode* stmt = inc->leaves[first]->parent;
+    while (stmt != NULL && (stmt->isTerminal || stmt->symbolIndex != inc->stmtIndex)) stmt = stmt->parent;
+    if (stmt == NULL || !isWithin(inc, inc->leaves[last], stmt)) return false;
+    if (first > 0 && isWithin(inc, inc->leaves[first - 1], stmt)) return false;
+    return last + 1 == inc->numLeaves || !isWithin(inc, inc->leaves[last + 1], stmt);
+}
+
+// Edit one statement line of the token stream and compare the incremental reparse with a
+// full parse of the edited tokens. The new line "b5 <--- b5 * 2;" replaces editLine, first
+// in place and then as two lines. Tokens end with TK_DOLLAR.
+void compareIncrementalReparse(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, int editLine) {
+    const char* lexemes[] = {"b5", "<---", "b5", "*", "2", ";"};
+    const char* names[] = {"TK_ID", "TK_ASSIGNOP", "TK_ID", "TK_MUL", "TK_NUM", "TK_SEM"};
+    Token newTokens[6];
+    struct timespec start, end;
+    
+    IncrementalParse* check = createIncrementalParse(grammar, parseTable, tokens, numTokens);
+    bool statementLine = isStatementLine(check, editLine);
+    freeIncrementalParse(check);
+    if (!statementLine) {
+        printf("\nIncremental reparse skipped: line %d is not a statement line\n", editLine);
+        return;
+    }
+    
+    for (int round = 0; round < 2; round++) {
+        // Round 1 splits the statement over editLine and editLine + 1
+        int numNew = 6, newLastLine = editLine + round;
+        for (int i = 0; i < numNew; i++) {
+            memset(&newTokens[i], 0, sizeof(Token));
+            snprintf(newTokens[i].lexeme, sizeof(newTokens[i].lexeme), "%s", lexemes[i]);
+            snprintf(newTokens[i].token, sizeof(newTokens[i].token), "%s", names[i]);
+            newTokens[i].lineNumber = (round == 1 && i >= 3) ? editLine + 1 : editLine;
+        }
+        
+        // The edited token stream, for the full parse
+        Token* edited = (Token*)malloc((numTokens + numNew) * sizeof(Token));
+        int n = 0;
+        bool inserted = false;
+        for (int i = 0; i < numTokens - 1; i++) {
+            if (tokens[i].lineNumber == editLine) {
+                if (!inserted) {
+                    memcpy(edited + n, newTokens, numNew * sizeof(Token));
+                    n += numNew;
+                    inserted = true;
+                }
+                continue;
+            }
+            edited[n] = tokens[i];
+            if (tokens[i].lineNumber > editLine) edited[n].lineNumber += round;
+            n++;
+        }
+        edited[n] = tokens[numTokens - 1];
+        if (edited[n].lineNumber >= editLine) edited[n].lineNumber += round;
+        n++;
+        
+        IncrementalParse* inc = createIncrementalParse(grammar, parseTable, tokens, numTokens);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bool incremental = reparseEditedLines(inc, editLine, editLine, newTokens, numNew, newLastLine);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double editMs = elapsedMs(&start, &end);
+        
+        bool error;
+        resolveTokenTerminals(grammar, edited, n);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ParseTreeNode* full = runPredictiveParser(grammar, parseTable, NULL, edited, n, false, NULL, &error);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double fullMs = elapsedMs(&start, &end);
+        
+        printf("\nIncremental reparse of line %d (%s): %s, %d of %d tokens parsed again\n",
+               editLine, round == 0 ? "same line count" : "one more line",
+               incremental ? "subtree spliced" : "full reparse", inc->reparsedTokens, n - 1);
+        printf("%.3f ms incremental, %.3f ms full parse, parse trees %s\n",
+               editMs, fullMs, parseTreesEqual(inc->root, full) ? "identical" : "DIFFER");
+        
+        freeParseTree(full);
+        freeIncrementalParse(inc);
+        free(edited);
+    }
+}
+
+static bool incrementalParsesEqual(IncrementalParse* a, IncrementalParse* b) {
+    if (a->error != b->error || a->numLeaves != b->numLeaves || a->numTokens != b->numTokens ||
+        !parseTreesEqual(a->root, b->root)) {
+        return false;
+    }
+    for (int i = 0; i < a->numTokens; i++) {
+        if (a->tokens[i].terminalIndex != b->tokens[i].terminalIndex ||
+            a->tokens[i].lineNumber != b->tokens[i].lineNumber ||
+            strcmp(a->tokens[i].lexeme, b->tokens[i].lexeme) != 0) {
+            return false;
+        }
+    }
+    for (int i = 0; i < a->numLeaves; i++) {
+        if (a->leaves[i]->symbolIndex != b->leaves[i]->symbolIndex ||
+            a->leaves[i]->lineNumber != b->leaves[i]->lineNumber ||
+            strcmp(a->leaves[i]->lexeme, b->leaves[i]->lexeme) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// An edit as checkIncrementalReparse can take it back: lines firstLine..newLastLine get
+// the old tokens of lines firstLine..lastLine again
+typedef struct {
+    int firstLine;
+    int lastLine;
+    int newLastLine;
+    Token* old;
+    int numOld;
+} UndoEdit;
+
+// Apply random edits one after another to the same IncrementalParse and compare it with a
+// fresh parse of the edited tokens after each one. An edit replaces one or two lines with
+// the tokens of another line, spread over one line more or less and sometimes one token
+// short; most edits replace a statement line with another statement. Edits go on through
+// syntax errors; while the input has one, most edits undo the edits since it last parsed
+// cleanly, so the check keeps moving into error states and back out of them.
+void checkIncrementalReparse(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens,
+                             int edits, unsigned int seed) {
+    if (numTokens < 2) return;
+    
+    int capacity = numTokens * 2;
+    Token* current = (Token*)malloc(capacity * sizeof(Token));
+    Token* edited = (Token*)malloc(capacity * sizeof(Token));
+    Token added[64];
+    UndoEdit* undo = NULL;
+    int numUndo = 0, undoCapacity = 0;
+    int n = numTokens;
+    int spliced = 0, errors = 0, undone = 0, mismatches = 0;
+    
+    memcpy(current, tokens, numTokens * sizeof(Token));
+    IncrementalParse* inc = createIncrementalParse(grammar, parseTable, current, n);
+    srand(seed);
+    
+    for (int edit = 0; edit < edits && n > 1; edit++) {
+        int lastSourceLine = current[n - 2].lineNumber;
+        int firstLine = 1 + rand() % lastSourceLine;
+        int lastLine = firstLine + rand() % 2;
+        if (lastLine > lastSourceLine) lastLine = lastSourceLine;
+        int newLastLine = lastLine + rand() % 3 - 1;
+        if (newLastLine < firstLine) newLastLine = firstLine;
+        int sourceLine = 1 + rand() % lastSourceLine;
+        
+        // Most edits swap one statement for another, so chains of edits stay valid
+        if (rand() % 4 != 0) {
+            for (int tries = 0; tries < 16 && !isStatementLine(inc, firstLine); tries++) {
+                firstLine = 1 + rand() % lastSourceLine;
+            }
+            for (int tries = 0; tries < 16 && !isStatementLine(inc, sourceLine); tries++) {
+                sourceLine = 1 + rand() % lastSourceLine;
+            }
+            lastLine = firstLine;
+            newLastLine = firstLine + rand() % 2;
+        }
+        
+        Token* newTokens = added;
+        int numNew = 0;
+        UndoEdit* taken = NULL;
+        if (inc->error && numUndo > 0 && rand() % 4 != 0) {
+            taken = &undo[--numUndo];
+            firstLine = taken->firstLine;
+            lastLine = taken->newLastLine;
+            newLastLine = taken->lastLine;
+            newTokens = taken->old;
+            numNew = taken->numOld;
+            undone++;
+        } else {
+            for (int i = 0; i < n - 1 && numNew < 64; i++) {
+                if (current[i].lineNumber != sourceLine) continue;
+                added[numNew] = current[i];
+                added[numNew].lineNumber = firstLine + rand() % (newLastLine - firstLine + 1);
+                if (numNew > 0 && added[numNew].lineNumber < added[numNew - 1].lineNumber) {
+                    added[numNew].lineNumber = added[numNew - 1].lineNumber;
+                }
+                numNew++;
+            }
+            if (numNew > 0 && rand() % 5 == 0) numNew--;
+            
+            if (numUndo == undoCapacity) {
+                undoCapacity = undoCapacity ? undoCapacity * 2 : 16;
+                undo = (UndoEdit*)realloc(undo, undoCapacity * sizeof(UndoEdit));
+            }
+            UndoEdit* record = &undo[numUndo++];
+            record->firstLine = firstLine;
+            record->lastLine = lastLine;
+            record->newLastLine = newLastLine;
+            record->old = (Token*)malloc(n * sizeof(Token));
+            record->numOld = 0;
+            for (int i = 0; i < n - 1; i++) {
+                if (current[i].lineNumber >= firstLine && current[i].lineNumber <= lastLine) {
+                    record->old[record->numOld++] = current[i];
+                }
+            }
+        }
+        
+        if (n + numNew > capacity) {
+            capacity = (n + numNew) * 2;
+            current = (Token*)realloc(current, capacity * sizeof(Token));
+            edited = (Token*)realloc(edited, capacity * sizeof(Token));
+        }
+        
+        // Tokens before the edit, the new tokens, the shifted tokens after it, TK_DOLLAR
+        int m = 0;
+        bool inserted = false;
+        for (int i = 0; i < n - 1; i++) {
+            int line = current[i].lineNumber;
+            if (line >= firstLine && line <= lastLine) continue;
+            if (!inserted && line > lastLine) {
+                memcpy(edited + m, newTokens, numNew * sizeof(Token));
+                m += numNew;
+                inserted = true;
+            }
+            edited[m] = current[i];
+            if (line > lastLine) edited[m].lineNumber += newLastLine - lastLine;
+            m++;
+        }
+        if (!inserted) {
+            memcpy(edited + m, newTokens, numNew * sizeof(Token));
+            m += numNew;
+        }
+        edited[m] = current[n - 1];
+        edited[m].lineNumber = m > 0 ? edited[m - 1].lineNumber : 1;
+        m++;
+        
+        if (reparseEditedLines(inc, firstLine, lastLine, newTokens, numNew, newLastLine)) spliced++;
+        IncrementalParse* fresh = createIncrementalParse(grammar, parseTable, edited, m);
+        if (!incrementalParsesEqual(inc, fresh)) mismatches++;
+        
+        // Edits are only undone back to the last clean parse
+        if (taken != NULL) free(taken->old);
+        if (fresh->error) {
+            errors++;
+        } else {
+            while (numUndo > 0) free(undo[--numUndo].old);
+        }
+        freeIncrementalParse(fresh);
+        
+        Token* swap = current;
+        current = edited;
+        edited = swap;
+        n = m;
+    }
+    
+    printf("\nRandomized incremental check: %d edits, %d spliced, %d left a syntax error, %d undone, "
+           "%d differ from a fresh parse\n", edits, spliced, errors, undone, mismatches);
+    
+    while (numUndo > 0) free(undo[--numUndo].old);
+    free(undo);
+    freeIncrementalParse(inc);
+    free(current);
+    free(edited);
+}
+
+// Insert a token the grammar does not know before each token in turn and check that the
+// tree, event, AST and streaming parses agree on whether the input has syntax errors.
+// Unknown tokens are skipped, so where the parser expects a non-terminal the input still
+// parses cleanly. tokens end with TK_DOLLAR; the streaming parse reads the others from
+// a scratch token file.
+void checkUnknownTokens(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens) {
+    const char* tokenFile = "unknown_tokens.txt";
+    const char* treeFile = "unknown_tree.txt";
+    AstRules* rules = createAstRules(grammar);
+    Token* edited = (Token*)malloc((numTokens + 1) * sizeof(Token));
+    ParseCallbacks callbacks = {NULL, NULL, NULL, NULL, NULL};
+    int clean = 0, disagreements = 0;
+    
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    for (int i = 0; i < numTokens; i++) {
+        memcpy(edited, tokens, i * sizeof(Token));
+        memcpy(edited + i + 1, tokens + i, (numTokens - i) * sizeof(Token));
+        memset(&edited[i], 0, sizeof(Token));
+        snprintf(edited[i].lexeme, sizeof(edited[i].lexeme), "?");
+        snprintf(edited[i].token, sizeof(edited[i].token), "TK_UNKNOWN");
+        edited[i].lineNumber = tokens[i].lineNumber;
+        edited[i].terminalIndex = -1;
+        
+        bool treeError, astError = false;
+        ParseTreeNode* tree = runPredictiveParser(grammar, parseTable, NULL, edited, numTokens + 1, false, NULL, &treeError);
+        bool eventError = !parseWithCallbacks(grammar, parseTable, NULL, edited, numTokens + 1, &callbacks);
+        if (rules != NULL) {
+            Arena arena = {NULL, 0};
+            buildAst(rules, parseTable, edited, numTokens + 1, &arena, NULL, &astError);
+            arenaFree(&arena);
+        } else {
+            astError = treeError;
+        }
+        freeParseTree(tree);
+        
+        bool pushError;
+        PushParser* state = createPushParser(grammar, parseTable);
+        parserFeed(state, edited, numTokens);
+        freeParseTree(parserFinish(state, &pushError));
+        
+        bool streamError = true;
+        FILE* file = fopen(tokenFile, "w");
+        if (file) {
+            for (int k = 0; k < numTokens; k++) {
+                fprintf(file, "Line no. %d\t Lexeme %s\t Token %s\n",
+                        edited[k].lineNumber, edited[k].lexeme, edited[k].token);
+            }
+            fclose(file);
+            int peak;
+            streamError = !streamParseTokens(grammar, parseTable, tokenFile, treeFile, &peak);
+        }
+        
+        if (!treeError) clean++;
+        if (eventError != treeError || astError != treeError || pushError != treeError ||
+            streamError != treeError) disagreements++;
+    }
+    
+    printf("\nUnknown token before each of %d tokens: %d inputs still parse cleanly, "
+           "error flags %s\n", numTokens, clean, disagreements == 0 ? "agree" : "DIFFER");
+    
+    remove(tokenFile);
+    remove(treeFile);
+    free(edited);
+    if (rules != NULL) freeAstRules(rules);
+}
+
+#ifdef USE_RD_PARSER
+#include "rd_parser.c"
+
+// Time the table-driven loop against the generated recursive-descent parser on the same tokens
+void benchmarkParsers(Grammar* grammar, ParseTable* parseTable, Token* tokens, int numTokens, int iterations) {
+    resolveTokenTerminals(grammar, tokens, numTokens);
+    
+    // Both engines must agree before their timings mean anything
+    bool tableError, rdError;
+    ParseTreeNode* tableTree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &tableError);
+    ParseTreeNode* rdTree = parseTokensRecursiveDescent(grammar, tokens, numTokens, &rdError);
+    bool same = parseTreesEqual(tableTree, rdTree) && tableError == rdError;
+    freeParseTree(tableTree);
+    freeParseTree(rdTree);
+    
+    struct timespec start, end;
+    double tableMs = 0, rdMs = 0;
+    
+    for (int i = 0; i < iterations; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ParseTreeNode* tree = runPredictiveParser(grammar, parseTable, NULL, tokens, numTokens, false, NULL, &tableError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        tableMs += elapsedMs(&start, &end);
+        freeParseTree(tree);
+        
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        tree = parseTokensRecursiveDescent(grammar, tokens, numTokens, &rdError);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        rdMs += elapsedMs(&start, &end);
+        freeParseTree(tree);
+    }
+    
+    printf("\nParser benchmark: %d tokens, %d iterations\n", numTokens, iterations);
+    printf("%-20s%12s%14s\n", "Engine", "ms/parse", "ns/token");
+    printf("%-20s%12.3f%14.1f\n", "table-driven", tableMs / iterations, tableMs * 1e6 / iterations / numTokens);
+    printf("%-20s%12.3f%14.1f\n", "recursive-descent", rdMs / iterations, rdMs * 1e6 / iterations / numTokens);
+    printf("Parse trees %s\n", same ? "identical" : "DIFFER");
+}
+#endif
+
+// Add parsing functionality to main function
+void parseSourceCode(Grammar* grammar, ParseTable* parseTable, const char* tokenFile, const char* parseTreeFile) {
+    int numTokens;
+    Token* tokens = readTokensFromFile(tokenFile, &numTokens);
+    
+    printf("Read %d tokens from %s\n", numTokens, tokenFile);
+    parseTokens(grammar, parseTable, tokens, numTokens, parseTreeFile, NULL);
+    
+    free(tokens);
+}
+
+// Main function to demonstrate functionality
+
+// Compare the other engines and tree outputs with the LL(1) parser on the same tokens.
+// Only run with --bench, since each one parses the input several times.
+static void runBenchmarks(Grammar* grammar, ParseTable* parseTable) {
+    // Second engine: LALR(1) on a grammar without the left-factored helper rules
+    Grammar* lalrGrammar = readGrammarFromFile("grammar_lalr.txt");
+    LALRTable* lalrTable = createLALRTable(lalrGrammar);
+    printf("\nLALR(1) table: %d states, %d shift/reduce and %d reduce/reduce conflicts, %zu bytes\n",
+           lalrTable->numStates, lalrTable->shiftReduceConflicts, lalrTable->reduceReduceConflicts,
+           parseTableMemory(&lalrTable->action) + parseTableMemory(&lalrTable->gotoTable));
+    
+    int numTokens;
+    Token* tokens = readTokensFromFile("output_t6.txt", &numTokens);
+    compareParserEngines(grammar, parseTable, lalrTable, tokens, numTokens, 10, "parse_tree6_lalr.txt");
+    compareCompactTree(grammar, parseTable, tokens, numTokens, 10, "parse_tree6_compact.txt");
+    compareDerivationTrace(grammar, parseTable, tokens, numTokens, 10);
+    runParseMetrics(grammar, parseTable, tokens, numTokens, 10);
+    compareAstWithParseTree(grammar, parseTable, tokens, numTokens, 10, "ast6.txt");
+    compareParallelParse(grammar, parseTable, tokens, numTokens, (int)sysconf(_SC_NPROCESSORS_ONLN), 10);
+    compareBinaryParseTree(grammar, parseTable, tokens, numTokens, "parse_tree6.bin", "parse_tree6_binary.txt");
+    compareJsonEmitters(grammar, parseTable, tokens, numTokens, 10, "parse_tree6.json", "parse_tree6.ndjson");
+    compareIndexedQueries(grammar, parseTable, tokens, numTokens, 1000);
+    comparePushParser(grammar, parseTable, tokens, numTokens, "output_t6.txt", 7);
+    compareIncrementalReparse(grammar, parseTable, tokens, numTokens, 11);
+    checkIncrementalReparse(grammar, parseTable, tokens, numTokens, 1000, 1);
+    checkUnknownTokens(grammar, parseTable, tokens, numTokens);
+    
+    // Same parse tree file without keeping the tokens or the tree in memory
+    int peakStackDepth;
+    bool streamOk = streamParseTokens(grammar, parseTable, "output_t6.txt", "parse_tree6_stream.txt", &peakStackDepth);
+    printf("\nStreaming parse %s, peak stack depth %d (%zu bytes)\n", streamOk ? "succeeded" : "found errors",
+           peakStackDepth, peakStackDepth * sizeof(StreamEntry));
+    
+    // Adaptive LL(*) prediction on a grammar that leaves lists and optional suffixes unfactored
+    Grammar* adaptiveGrammar = readGrammarFromFile("grammar_adaptive.txt");
+    FirstAndFollow* adaptiveFafl = computeFirstAndFollowSets(adaptiveGrammar);
+    ParseTable* adaptiveTable = (ParseTable*)malloc(sizeof(ParseTable));
+    createParseTable(adaptiveFafl, adaptiveTable, adaptiveGrammar);
+    AdaptivePredictor* predictor = createAdaptivePredictor(adaptiveGrammar, adaptiveFafl);
+    compareAdaptivePrediction(grammar, parseTable, adaptiveGrammar, adaptiveTable, predictor,
+                              tokens, numTokens, 10, "parse_tree6_adaptive.txt");
+    freeAdaptivePredictor(predictor);
+#ifdef USE_RD_PARSER
+    benchmarkParsers(grammar, parseTable, tokens, numTokens, 10);
+#endif
+    free(tokens);
+}
+
+// Usage: parser [--bench]
+int main(int argc, char* argv[]) {
+    bool bench = argc > 1 && strcmp(argv[1], "--bench") == 0;
+
+    Grammar* grammar = readGrammarFromFile("grammar.txt");
+    printGrammar(grammar);
+    
+    FirstAndFollow* fafl = computeFirstAndFollowSets(grammar);
+    printFirstSets(grammar, fafl);
+    printFollowSets(grammar, fafl);
+    
+    ParseTable* parseTable = (ParseTable*)malloc(sizeof(ParseTable));
+    createParseTable(fafl, parseTable, grammar);
+    printParseTable(parseTable, grammar);
+    printf("\nParse table uses %zu bytes (%s)\n", parseTableMemory(parseTable),
+           parseTable->compressed ? "compressed" : "dense");
+
+    // Write parse table to files in different formats for better visualization
+    writeParseTableToCsv(parseTable, grammar, "parse_table_all.csv");
+    writeParseTableToHtml(parseTable, grammar, "parse_table_all.html");
+
+    // Direct-coded alternative to the table-driven loop, build with -DUSE_RD_PARSER to use it
+    generateRecursiveDescentParser(grammar, parseTable, "rd_parser.c");
+
+    // Parse source code using lexer output with hardcoded file names
+    printf("\nParsing source code from lexer output...\n");
+    parseSourceCode(grammar, parseTable, "output_t6.txt", "parse_tree6.txt");
+    
+    if (bench) runBenchmarks(grammar, parseTable);
+    
+    return 0;
+}